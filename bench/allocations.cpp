@@ -0,0 +1,145 @@
+#define NONIUS_RUNNER
+#include <nonius/nonius_single.h++>
+#include <async_json/json_extractor.hpp>
+#include <array>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <memory_resource>
+#include <new>
+#include <optional>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+// heap allocations per document when extracted strings and containers live on the global heap, in a std::pmr arena that
+// is released after every document, or are views copied into that arena
+
+std::size_t allocations = 0;
+
+void* operator new(std::size_t size)
+{
+    ++allocations;
+    if (auto ptr = std::malloc(size ? size : 1)) return ptr;
+    throw std::bad_alloc();
+}
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+namespace
+{
+struct heap_items
+{
+    std::vector<std::string> kinds;
+    std::vector<std::string> etags;
+    std::vector<std::string> video_ids;
+    std::string              region;
+    long                     total{0};
+};
+
+struct arena_items
+{
+    explicit arena_items(std::pmr::memory_resource* mr) : kinds(mr), etags(mr), video_ids(mr), region(mr) {}
+    std::pmr::vector<std::pmr::string> kinds;
+    std::pmr::vector<std::pmr::string> etags;
+    std::pmr::vector<std::pmr::string> video_ids;
+    std::pmr::string                   region;
+    long                               total{0};
+};
+
+struct view_items
+{
+    explicit view_items(std::pmr::memory_resource* mr) : kinds(mr), etags(mr), video_ids(mr) {}
+    std::pmr::vector<std::string_view> kinds;
+    std::pmr::vector<std::string_view> etags;
+    std::pmr::vector<std::string_view> video_ids;
+    std::string_view                   region;
+    long                               total{0};
+};
+
+std::string const& document()
+{
+    static std::string const doc = []
+    {
+        std::string ret = R"({"kind": "youtube#searchListResponse", "regionCode": "KE", "pageInfo": {"totalResults": 4249}, "items": [)";
+        for (int i = 0; i != 200; ++i)
+        {
+            if (i) ret += ",";
+            ret += R"({"kind": "youtube#searchResult", "etag": "\"m2yskBQFythfE4irbTIeOgYYfBU/QpOIr3QKlV5EUlzfFcVvDiJT0hw)" +
+                   std::to_string(i) + R"(\"", "id": {"kind": "youtube#video", "videoId": "IGYEtw94zMM)" + std::to_string(i) + R"("}})";
+        }
+        return ret + "]}";
+    }();
+    return doc;
+}
+
+// the extractor is built once, the items of the current document are reached through items
+template <typename Items, typename Strings>
+auto make_items_parser(std::optional<Items>& items, Strings strings)
+{
+    using namespace async_json;
+    auto const field = [&items](auto member) { return [&items, member]() -> auto& { return (*items).*member; }; };
+    return make_extractor([](auto) { std::cerr << "It failed\n"; },                              //
+                          path(strings(field(&Items::kinds)), "items", "kind"),                   //
+                          path(strings(field(&Items::etags)), "items", "etag"),                   //
+                          path(strings(field(&Items::video_ids)), "items", "id", "videoId"),      //
+                          path(strings(field(&Items::region)), "regionCode"),                     //
+                          path(assign_numeric(field(&Items::total)), "pageInfo", "totalResults"));
+}
+
+void report(char const* name, std::size_t count)
+{
+    static std::set<std::string> reported;
+    if (reported.insert(name).second) std::cout << name << ": " << count << " allocations per document\n";
+}
+
+template <typename Items, typename Parser, typename Make, typename Release>
+void run(nonius::chronometer meter, char const* name, std::optional<Items>& items, Parser& parser, Make make, Release release)
+{
+    auto const& input     = document();
+    auto const  parse_one = [&]
+    {
+        items.emplace(make());
+        parser.parse_bytes(input);
+        parser.reset();
+        auto const total = items->total;
+        items.reset();
+        release();
+        return total;
+    };
+    parse_one();
+    auto const before = allocations;
+    parse_one();
+    report(name, allocations - before);
+    meter.measure(parse_one);
+}
+}  // namespace
+
+NONIUS_BENCHMARK("extract_heap_strings",
+                 [](nonius::chronometer meter)
+                 {
+                     std::optional<heap_items> items;
+                     auto parser = make_items_parser(items, [](auto field) { return async_json::assign_string(std::move(field)); });
+                     run(meter, "extract_heap_strings", items, parser, [] { return heap_items{}; }, [] {});
+                 })
+
+NONIUS_BENCHMARK("extract_pmr_strings",
+                 [](nonius::chronometer meter)
+                 {
+                     static std::array<std::byte, 256 * 1024> buffer;
+                     std::pmr::monotonic_buffer_resource      arena(buffer.data(), buffer.size());
+                     std::optional<arena_items>               items;
+                     auto parser = make_items_parser(items, [](auto field) { return async_json::assign_string(std::move(field)); });
+                     run(meter, "extract_pmr_strings", items, parser, [&] { return arena_items(&arena); }, [&] { arena.release(); });
+                 })
+
+NONIUS_BENCHMARK("extract_arena_views",
+                 [](nonius::chronometer meter)
+                 {
+                     static std::array<std::byte, 256 * 1024> buffer;
+                     std::pmr::monotonic_buffer_resource      arena(buffer.data(), buffer.size());
+                     std::optional<view_items>                items;
+                     auto parser = make_items_parser(items, [&arena](auto field) { return async_json::assign_string(std::move(field), arena); });
+                     run(meter, "extract_arena_views", items, parser, [&] { return view_items(&arena); }, [&] { arena.release(); });
+                 })
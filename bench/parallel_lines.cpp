@@ -0,0 +1,96 @@
+#define NONIUS_RUNNER
+#include <nonius/nonius_single.h++>
+#include <async_json/json_extractor.hpp>
+#include <async_json/parallel_lines.hpp>
+#include <async_json/struct_binding.hpp>
+#include <iostream>
+#include <string>
+
+// throughput of parse_lines_parallel on a generated JSON Lines corpus with an increasing number of worker threads, with
+// extractor paths and with a bound struct
+
+namespace
+{
+struct account
+{
+    std::string name;
+};
+
+struct record
+{
+    long        id{0};
+    account     user;
+    double      score{0.0};
+};
+}  // namespace
+
+template <>
+struct async_json::binding<account>
+{
+    static constexpr auto fields = async_json::fields(async_json::field("name", &account::name));
+};
+
+template <>
+struct async_json::binding<record>
+{
+    static constexpr auto fields = async_json::fields(async_json::field("id", &record::id), async_json::field("user", &record::user),
+                                                      async_json::field("score", &record::score));
+};
+
+namespace
+{
+
+std::string const& corpus()
+{
+    static std::string const lines = []
+    {
+        std::string ret;
+        for (long i = 0; i != 200000; ++i)
+        {
+            ret += R"({"id":)" + std::to_string(i) + R"(,"user":{"name":"user)" + std::to_string(i % 977) +
+                   R"(","roles":["reader","writer"],"active":true},"score":)" + std::to_string(i % 1000) +
+                   R"(.25,"tags":["a","b","c"],"meta":{"created":"2024-01-01T00:00:00Z","source":null}})" "\n";
+        }
+        return ret;
+    }();
+    return lines;
+}
+
+auto make_record_parser(record& r)
+{
+    using namespace async_json;
+    return make_extractor([](auto) { std::cerr << "It failed\n"; },  //
+                          path(assign_numeric(r.id), "id"),           //
+                          path(assign_string(r.user.name), "user", "name"),  //
+                          path(assign_numeric(r.score), "score"));
+}
+
+auto make_struct_record_parser(record& r)
+{
+    return async_json::make_struct_parser([](auto) { std::cerr << "It failed\n"; }, r);
+}
+
+template <typename MakeParser>
+void run(nonius::chronometer meter, unsigned threads, MakeParser make_parser)
+{
+    auto const& input = corpus();
+    meter.measure(
+        [&]
+        {
+            long sum = 0;
+            async_json::parse_lines_parallel<record>(
+                input, make_parser, [&](std::size_t, async_json::parse_status, record&& r) { sum += r.id; },
+                async_json::parallel_options{threads, 256 * 1024, async_json::delivery::unordered});
+            return sum;
+        });
+}
+}  // namespace
+
+NONIUS_BENCHMARK("parallel_lines_1_thread", [](nonius::chronometer meter) { run(meter, 1, make_record_parser); })
+NONIUS_BENCHMARK("parallel_lines_2_threads", [](nonius::chronometer meter) { run(meter, 2, make_record_parser); })
+NONIUS_BENCHMARK("parallel_lines_4_threads", [](nonius::chronometer meter) { run(meter, 4, make_record_parser); })
+NONIUS_BENCHMARK("parallel_lines_8_threads", [](nonius::chronometer meter) { run(meter, 8, make_record_parser); })
+NONIUS_BENCHMARK("parallel_lines_struct_1_thread", [](nonius::chronometer meter) { run(meter, 1, make_struct_record_parser); })
+NONIUS_BENCHMARK("parallel_lines_struct_2_threads", [](nonius::chronometer meter) { run(meter, 2, make_struct_record_parser); })
+NONIUS_BENCHMARK("parallel_lines_struct_4_threads", [](nonius::chronometer meter) { run(meter, 4, make_struct_record_parser); })
+NONIUS_BENCHMARK("parallel_lines_struct_8_threads", [](nonius::chronometer meter) { run(meter, 8, make_struct_record_parser); })
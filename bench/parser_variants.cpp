@@ -1,7 +1,24 @@
 #define NONIUS_RUNNER
 #include <nonius/nonius_single.h++>
 #include <async_json/json_extractor.hpp>
+#include <async_json/struct_binding.hpp>
 #include <ranges>
+#include <functional>
+
+// the parser as make_extractor built it before: extractor hidden behind the default std::function handler
+template <typename IT, typename EH, typename... Ts>
+auto make_type_erased_extractor(EH&& eh, Ts&&... ts)
+{
+    using namespace async_json;
+    return basic_json_parser<std::function<void(saj_event_value<default_traits> const&)>, default_traits, IT>(
+        detail::extractor<default_traits, EH, Ts...>(std::forward<EH>(eh), std::forward<Ts>(ts)...));
+}
+
+struct event_counter
+{
+    size_t events{0};
+    void   operator()(async_json::saj_event_value<async_json::default_traits> const&) { ++events; }
+};
 
 char const model_data[] = R"(
 {
@@ -156,3 +173,219 @@ NONIUS_BENCHMARK("parse_with_unrolled",
                      parser.parse_bytes({model_data, sizeof(model_data)});
                  })
 
+
+NONIUS_BENCHMARK("parse_with_tables_type_erased_handler",
+                 []
+                 {
+                     using namespace async_json;
+                     auto parser = make_type_erased_extractor<table_tag>(        //
+                         [](auto error) { std::cerr << "It failed\n"; },         //
+                         path([](auto const&) {}, "nextPageToken"),              //
+                         path(                                                   //
+                             all(                                                //
+                                 path([](auto const&) {}, "etag"),               //
+                                 path([](auto const&) {}, "id", "channelId")     //
+                                 ),                                              //
+                             "result", "items")                                  //
+                     );
+                     parser.parse_bytes({model_data, sizeof(model_data)});
+                 })
+
+NONIUS_BENCHMARK("parse_with_unrolled_type_erased_handler",
+                 []
+                 {
+                     using namespace async_json;
+                     auto parser = make_type_erased_extractor<unrolled_tag>(          //
+                         [](auto error) { std::cerr << "It failed\n"; },              //
+                         fast_path([](auto const&) {}, "nextPageToken"),              //
+                         fast_path(                                                   //
+                             all(                                                     //
+                                 fast_path([](auto const&) {}, "etag"),               //
+                                 fast_path([](auto const&) {}, "id", "channelId")     //
+                                 ),                                                   //
+                             "result", "items")                                       //
+                     );
+                     parser.parse_bytes({model_data, sizeof(model_data)});
+                 })
+
+NONIUS_BENCHMARK("parse_with_fused_type_erased_handler",
+                 []
+                 {
+                     using namespace async_json;
+                     auto parser = make_type_erased_extractor<fused_tag>(        //
+                         [](auto error) { std::cerr << "It failed\n"; },         //
+                         path([](auto const&) {}, "nextPageToken"),              //
+                         path(                                                   //
+                             all(                                                //
+                                 path([](auto const&) {}, "etag"),               //
+                                 path([](auto const&) {}, "id", "channelId")     //
+                                 ),                                              //
+                             "result", "items")                                  //
+                     );
+                     parser.parse_bytes({model_data, sizeof(model_data)});
+                 })
+
+NONIUS_BENCHMARK("count_events_type_erased_handler",
+                 [](nonius::chronometer meter)
+                 {
+                     using namespace async_json;
+                     basic_json_parser<std::function<void(saj_event_value<default_traits> const&)>> parser(event_counter{});
+                     meter.measure(
+                         [&]
+                         {
+                             parser.reset();
+                             return parser.parse_bytes({model_data, sizeof(model_data)});
+                         });
+                 })
+
+NONIUS_BENCHMARK("count_events_concrete_handler",
+                 [](nonius::chronometer meter)
+                 {
+                     using namespace async_json;
+                     basic_json_parser<event_counter> parser(event_counter{});
+                     meter.measure(
+                         [&]
+                         {
+                             parser.reset();
+                             return parser.parse_bytes({model_data, sizeof(model_data)});
+                         });
+                 })
+
+// the same parser with the three interpreters, only the state machine differs
+NONIUS_BENCHMARK("count_events_unrolled",
+                 [](nonius::chronometer meter)
+                 {
+                     using namespace async_json;
+                     basic_json_parser<event_counter, default_traits, unrolled_tag> parser(event_counter{});
+                     meter.measure(
+                         [&]
+                         {
+                             parser.reset();
+                             return parser.parse_bytes({model_data, sizeof(model_data)});
+                         });
+                 })
+
+NONIUS_BENCHMARK("count_events_fused",
+                 [](nonius::chronometer meter)
+                 {
+                     using namespace async_json;
+                     basic_json_parser<event_counter, default_traits, fused_tag> parser(event_counter{});
+                     meter.measure(
+                         [&]
+                         {
+                             parser.reset();
+                             return parser.parse_bytes({model_data, sizeof(model_data)});
+                         });
+                 })
+
+template <typename Traits>
+struct traits_event_counter
+{
+    size_t events{0};
+    void   operator()(async_json::saj_event_value<Traits> const&) { ++events; }
+};
+
+// compare with count_events_concrete_handler for the cost of checking strings and names
+NONIUS_BENCHMARK("count_events_validate_utf8",
+                 [](nonius::chronometer meter)
+                 {
+                     using namespace async_json;
+                     basic_json_parser<traits_event_counter<validate_utf8_traits>, validate_utf8_traits> parser(
+                         traits_event_counter<validate_utf8_traits>{});
+                     meter.measure(
+                         [&]
+                         {
+                             parser.reset();
+                             return parser.parse_bytes({model_data, sizeof(model_data)});
+                         });
+                 })
+
+struct search_id
+{
+    std::string kind;
+    std::string video_id;
+    std::string channel_id;
+};
+struct search_item
+{
+    std::string kind;
+    std::string etag;
+    search_id   id;
+};
+struct page_info
+{
+    long total_results{0};
+    long results_per_page{0};
+};
+struct search_response
+{
+    std::string              next_page_token;
+    std::string              region_code;
+    page_info                info;
+    std::vector<search_item> items;
+};
+
+template <>
+struct async_json::binding<search_id>
+{
+    static constexpr auto fields = async_json::fields(field("kind", &search_id::kind), field("videoId", &search_id::video_id),
+                                                      field("channelId", &search_id::channel_id));
+};
+template <>
+struct async_json::binding<search_item>
+{
+    static constexpr auto fields =
+        async_json::fields(field("kind", &search_item::kind), field("etag", &search_item::etag), field("id", &search_item::id));
+};
+template <>
+struct async_json::binding<page_info>
+{
+    static constexpr auto fields =
+        async_json::fields(field("totalResults", &page_info::total_results), field("resultsPerPage", &page_info::results_per_page));
+};
+template <>
+struct async_json::binding<search_response>
+{
+    static constexpr auto fields =
+        async_json::fields(field("nextPageToken", &search_response::next_page_token), field("regionCode", &search_response::region_code),
+                           field("pageInfo", &search_response::info), field("items", &search_response::items));
+};
+
+// the same members filled with one path per field, compare with extract_struct_binding
+NONIUS_BENCHMARK("extract_with_paths",
+                 [](nonius::chronometer meter)
+                 {
+                     meter.measure(
+                         []
+                         {
+                             using namespace async_json;
+                             search_response          r;
+                             std::vector<std::string> kinds, etags, id_kinds, video_ids, channel_ids;
+                             auto                     parser = make_extractor(                                        //
+                                 [](auto) { std::cerr << "It failed\n"; },                                           //
+                                 path(assign_string(r.next_page_token), "nextPageToken"),                         //
+                                 path(assign_string(r.region_code), "regionCode"),                                //
+                                 path(assign_numeric(r.info.total_results), "pageInfo", "totalResults"),          //
+                                 path(assign_numeric(r.info.results_per_page), "pageInfo", "resultsPerPage"),     //
+                                 path(assign_string(kinds), "items", "kind"),                                     //
+                                 path(assign_string(etags), "items", "etag"),                                     //
+                                 path(assign_string(id_kinds), "items", "id", "kind"),                            //
+                                 path(assign_string(video_ids), "items", "id", "videoId"),                        //
+                                 path(assign_string(channel_ids), "items", "id", "channelId"));
+                             parser.parse_bytes({model_data, sizeof(model_data)});
+                             return kinds.size();
+                         });
+                 })
+
+NONIUS_BENCHMARK("extract_struct_binding",
+                 [](nonius::chronometer meter)
+                 {
+                     meter.measure(
+                         []
+                         {
+                             search_response r;
+                             auto parser = async_json::make_struct_parser([](auto) { std::cerr << "It failed\n"; }, r);
+                             parser.parse_bytes({model_data, sizeof(model_data)});
+                             return r.items.size();
+                         });
+                 })
@@ -53,6 +53,8 @@ struct basic_is_path
 
     constexpr inline bool  at_end() const noexcept { return element == path_elements.size(); }
     constexpr inline int   depth() const noexcept { return dislocation; }
+    /// true when the next value belongs to a member that is not on the path, so it can be skipped entirely
+    constexpr inline bool  skippable() const noexcept { return off_path_value; }
     bool matches_element_begin(std::string_view const& sv) noexcept;
     bool matches_element_part(std::string_view const& sv) noexcept;
     bool element_complete() noexcept;
@@ -65,6 +67,7 @@ struct basic_is_path
     int         dislocation{0};
     size_t      element{0};
     size_t      pos{0};
+    bool        off_path_value{false};
     event_value cur;
 };
 
@@ -6,15 +6,77 @@
 
 #ifndef ASYNC_JSON_BASIC_JSON_PARSER_HPP_INCLUDED
 #define ASYNC_JSON_BASIC_JSON_PARSER_HPP_INCLUDED
-#include <cmath>
+#include <algorithm>
+#include <array>
+#include <string>
+#include <utility>
 #include <hsm/hsm.hpp>
 #include <hsm/unroll_sm.hpp>
 #include <async_json/default_traits.hpp>
 #include <async_json/saj_event_value.hpp>
+#include <async_json/name_hash.hpp>
+#include <async_json/string_converter.hpp>
+#include <async_json/detail/simd_scan.hpp>
+#include <async_json/detail/utf8_scan.hpp>
+#include <async_json/detail/nesting_stack.hpp>
+#include <async_json/detail/decimal_to_binary.hpp>
 namespace async_json
 {
 struct unrolled_tag;
 struct table_tag;
+/// Interpreter that looks up action and next state of each input byte in a single state x character class table
+/// instead of going through the hsm state machine.
+struct fused_tag;
+
+namespace detail
+{
+template <typename Handler, typename = void>
+struct has_flush : std::false_type
+{
+};
+template <typename Handler>
+struct has_flush<Handler, std::void_t<decltype(std::declval<Handler&>().flush())>> : std::true_type
+{
+};
+template <typename Handler, typename = void>
+struct has_clear : std::false_type
+{
+};
+template <typename Handler>
+struct has_clear<Handler, std::void_t<decltype(std::declval<Handler&>().clear())>> : std::true_type
+{
+};
+template <typename Handler, typename = void>
+struct has_suspend_request : std::false_type
+{
+};
+template <typename Handler>
+struct has_suspend_request<Handler, std::void_t<decltype(bool(std::declval<Handler&>().suspend_requested()))>> : std::true_type
+{
+};
+template <typename Handler, typename = void>
+struct has_skip_request : std::false_type
+{
+};
+template <typename Handler>
+struct has_skip_request<Handler, std::void_t<decltype(bool(std::declval<Handler&>().skip_requested()))>> : std::true_type
+{
+};
+}  // namespace detail
+
+enum class parse_status
+{
+    done,       ///< the top level value is complete, or in multi document mode no document is open
+    need_more,  ///< the whole input was consumed, the value is incomplete
+    suspended,  ///< the handler asked for a pause, the input after consumed bytes has to be passed in again
+    error       ///< a parse_error event was emitted
+};
+
+struct parse_result
+{
+    parse_status status;
+    size_t       consumed;
+};
 
 template <typename Handler = std::function<void(saj_event_value<default_traits> const&)>, typename Traits = default_traits, typename InterpreterTag = table_tag>
 struct basic_json_parser
@@ -23,6 +85,11 @@ struct basic_json_parser
     using integer_t = typename Traits::integer_t;
     using sv_t      = typename Traits::sv_t;
     using event_value = saj_event_value<Traits>;
+    static constexpr bool raw_numbers    = detail::has_raw_numbers<Traits>::value;
+    static constexpr bool multi_document = detail::has_multi_document<Traits>::value;
+    static constexpr bool name_hashes    = detail::has_name_hashes<Traits>::value;
+    static constexpr bool decode_escapes  = detail::has_decode_escapes<Traits>::value;
+    static constexpr bool utf8_validation = detail::has_validate_utf8<Traits>::value;
 
    private:
     Handler cbs;
@@ -40,28 +107,112 @@ struct basic_json_parser
     sv_t            parsed_view;
     sv_t            current_input_buffer;
 
-    int                  num_sign{1};
-    int                  exp_sign{1};
-    int                  frac_digits{0};
-    unsigned long long   exp_number{0};
-    unsigned long long   int_number{0};
-    unsigned long long   fraction{0};
-    std::vector<uint8_t> state_stack;
+    int                    num_sign{1};
+    int                    exp_sign{1};
+    unsigned long long     exp_number{0};
+    unsigned long long     int_number{0};
+    detail::decimal_number decimal;
+    char const*            number_begin{nullptr};
+    bool                   number_started{false};
+    detail::nesting_stack<Traits> state_stack;
+    bool                   in_document{false};
+    bool                   skip_line{false};
+    struct value_skip
+    {
+        size_t depth{0};
+        bool   active{false};
+        bool   in_string{false};
+        bool   escaped{false};
+    };
+    value_skip skip_state;
+    std::uint64_t name_hash{name_hash_seed};
+    // with decode_escapes: strings and names with escape sequences or split across buffers are collected here
+    std::string scratch;
+    bool        text_escaped{false};
+    bool        text_buffered{false};
+    detail::utf8_state text_utf8;
+    error_cause        text_error{no_error};
     using self_t = basic_json_parser;
-    std::function<bool(sv_t const&, int, self_t&)> process_events;
+    std::function<parse_result(sv_t const&, int, self_t&)> process_events;
 
    private:
     auto get_fraction_we() -> float_t ; 
     auto get_number() -> integer_t;
     auto get_fraction() -> float_t;
+    auto get_float(std::int64_t exp10) -> float_t;
     auto setup_sm() -> void;
+    auto advance(size_t count) -> void;
+    auto consume_string_run() -> void;
+    auto consume_whitespace() -> void;
+    auto consume_digits(bool fraction) -> void;
+    auto consume_exponent_digits() -> void;
+    template <typename SM>
+    auto consume_keyword(SM& sm) -> bool;
+    auto emit_number_span(bool last) -> void;
+    auto emit_name_part(saj_event ev) -> void;
+    auto emit_name_end() -> void;
+    auto buffer_text_part() -> void;
+    auto decode_text() -> bool;
+    auto check_text_part() -> bool;
+    auto finish_text() -> bool;
+    auto clear_document_state() -> void;
+    auto begin_document() -> void;
+    template <typename SM>
+    auto end_document(SM& sm) -> void;
+    template <typename SM>
+    auto abandon_document(SM& sm) -> void;
+    auto skip_to_next_line() -> bool;
+    auto begin_skip() -> bool;
+    auto skip_value() -> bool;
+    auto suspend_requested() -> bool
+    {
+        if constexpr (detail::has_suspend_request<Handler>::value)
+            return cbs.suspend_requested();
+        else
+            return false;
+    }
 
    public:
     explicit basic_json_parser(Handler&& handler);
     basic_json_parser();
 
     auto callback_handler() { return &cbs; }
-    auto parse_bytes(sv_t const& input) -> bool { return process_events(input, 0, *this); }
+    auto parse_bytes(sv_t const& input) -> bool
+    {
+        auto rest = input;
+        auto ret  = parse_some(rest);
+        while (ret.status == parse_status::suspended)
+        {
+            rest = rest.substr(ret.consumed);
+            ret  = parse_some(rest);
+        }
+        return ret.status != parse_status::error;
+    }
+    /// Parses input until it is consumed, an error occurs or the handler requests a pause.
+    /// Handlers with a bool suspend_requested() member are polled after each token, when it returns true parsing stops
+    /// and the remaining input starting at consumed bytes has to be passed in again to continue.
+    /// Handlers with a bool skip_requested() member are polled whenever a value begins, when it returns true the value
+    /// is dropped without emitting events or being validated, also across calls.
+    /// With decode_escapes the view of a string or name may point into a scratch buffer that is reused by the next one,
+    /// handlers that keep events beyond that have to copy the text, like batched_handler does.
+    auto parse_some(sv_t const& input) -> parse_result
+    {
+        auto const ret = process_events(input, 0, *this);
+        // handlers that buffer events have to pass them on while the input buffer is still valid
+        if constexpr (detail::has_flush<Handler>::value) cbs.flush();
+        return ret;
+    }
+    /// Ends the input. A number at the top level, also a skipped one or a skipped keyword, is completed, any other value
+    /// that is still open is reported with a parse_error event with incomplete_input. Returns done or error, or
+    /// suspended when the handler asked for a pause, then finish() has to be called again. In multi document mode only
+    /// the open document is incomplete.
+    auto finish() -> parse_result
+    {
+        auto const ret = process_events(sv_t{}, 1, *this);
+        if constexpr (detail::has_flush<Handler>::value) cbs.flush();
+        return ret;
+    }
+    /// Restarts the parser for a new input, handlers with a clear() member are cleared as well.
     auto reset() -> void;
 };
 
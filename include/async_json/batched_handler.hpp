@@ -0,0 +1,96 @@
+/* ==========================================================================
+ Copyright (c) 2024 Andreas Pokorny
+ Distributed under the Boost Software License, Version 1.0. (See accompanying
+ file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+========================================================================== */
+
+#ifndef ASYNC_JSON_BATCHED_HANDLER_HPP_INCLUDED
+#define ASYNC_JSON_BATCHED_HANDLER_HPP_INCLUDED
+
+#include <array>
+#include <cstddef>
+#include <string>
+#include <type_traits>
+#include <async_json/basic_json_parser.hpp>
+
+namespace async_json
+{
+/// Parser handler that collects events in a fixed size buffer and passes them to the consumer as a contiguous range
+/// of events: consumer(event_value const* first, event_value const* last).
+/// The buffer is handed over when it is full and at the end of every basic_json_parser::parse_some call, so
+/// string views within the events still refer to the current input buffer. With decode_escapes strings and names may
+/// be views of a scratch buffer of the parser that the next string overwrites, so their text is copied into a buffer
+/// of the batch that is valid until the consumer returns.
+template <typename Consumer, typename Traits = default_traits, std::size_t Capacity = 256>
+struct batched_handler
+{
+    static_assert(Capacity > 0);
+    using event_value                 = saj_event_value<Traits>;
+    using sv_t                        = typename Traits::sv_t;
+    static constexpr bool copies_text = detail::has_decode_escapes<Traits>::value;
+
+    Consumer consumer;
+
+    batched_handler() = default;
+    explicit batched_handler(Consumer&& c) : consumer(std::move(c)) {}
+
+    void operator()(event_value const& ev)
+    {
+        events[size] = ev;
+        if constexpr (copies_text)
+        {
+            if (has_text(ev))
+            {
+                auto const sv = ev.as_string_view();
+                text.append(sv.data(), sv.size());
+            }
+        }
+        if (++size == Capacity) flush();
+    }
+    void flush()
+    {
+        if (size == 0) return;
+        if constexpr (copies_text)
+        {
+            // the copies are appended in event order, the views are only redirected once text no longer grows
+            char const* copy = text.data();
+            for (auto ev = events.data(), last = ev + size; ev != last; ++ev)
+            {
+                if (!has_text(*ev)) continue;
+                auto const length = ev->as_string_view().size();
+                *ev               = event_value(ev->event, sv_t(copy, length));
+                copy += length;
+            }
+        }
+        consumer(events.data(), events.data() + size);
+        size = 0;
+        if constexpr (copies_text) text.clear();
+    }
+
+   private:
+    struct no_text
+    {
+    };
+    static constexpr bool has_text(event_value const& ev) noexcept
+    {
+        return ev.event == saj_event::string_value_start || ev.event == saj_event::object_name_start;
+    }
+
+    std::array<event_value, Capacity>                     events;
+    std::size_t                                           size{0};
+    std::conditional_t<copies_text, std::string, no_text> text;
+};
+
+template <typename Consumer, typename Traits = default_traits, typename InterpreterTag = table_tag, std::size_t Capacity = 256>
+using basic_batched_json_parser = basic_json_parser<batched_handler<Consumer, Traits, Capacity>, Traits, InterpreterTag>;
+
+template <typename Consumer>
+auto make_batched_parser(Consumer&& consumer)
+{
+    using handler_t = batched_handler<std::decay_t<Consumer>>;
+    return basic_json_parser<handler_t>(handler_t(std::decay_t<Consumer>(std::forward<Consumer>(consumer))));
+}
+
+}  // namespace async_json
+
+#endif
@@ -7,6 +7,9 @@
 #ifndef ASYNC_JSON_DEFAULT_TRAITS_HPP_INCLUDED
 #define ASYNC_JSON_DEFAULT_TRAITS_HPP_INCLUDED
 
+#include <cstddef>
+#include <type_traits>
+
 // get string view:
 
 #if __cplusplus >= 201703L
@@ -31,7 +34,11 @@ enum error_cause
     colon_exp,
     unexpected_character,
     invalid_number,
-    comma_expected
+    comma_expected,
+    nesting_too_deep,
+    invalid_escape,
+    invalid_utf8,
+    incomplete_input
 };
 
 struct default_traits
@@ -41,6 +48,94 @@ struct default_traits
     using sv_t      = std::string_view;
 };
 
+/// Numbers are not converted but reported as number_value_start/cont/end spans of the input.
+struct raw_number_traits : default_traits
+{
+    static constexpr bool raw_numbers = true;
+};
+
+/// Values separated by whitespace, e.g. JSON Lines, are parsed back to back, each framed by document_start and
+/// document_end events. After a parse error the rest of the line is skipped and parsing continues with the next line.
+struct multi_document_traits : default_traits
+{
+    static constexpr bool multi_document = true;
+};
+
+/// Objects and arrays may be nested at most MaxDepth levels deep, deeper input is reported as nesting_too_deep.
+/// The nesting levels are kept in a fixed size bitset instead of a heap allocated stack.
+template <std::size_t MaxDepth>
+struct max_depth_traits : default_traits
+{
+    static constexpr std::size_t max_depth = MaxDepth;
+};
+
+/// object_name_end carries the hash of the name, see hash_name in async_json/name_hash.hpp.
+/// The hash is continued over the parts of names split across input buffers, so no part has to be copied.
+struct name_hash_traits : default_traits
+{
+    static constexpr bool name_hashes = true;
+};
+
+/// Escape sequences in strings and names are replaced while parsing and each string or name is reported in a single
+/// string_value_start or object_name_start event. Strings without escape sequences that are within one input buffer
+/// are views of the input, all others are views of a scratch buffer of the parser that is valid until the next event.
+/// Invalid escape sequences are reported as invalid_escape.
+struct decode_escapes_traits : default_traits
+{
+    static constexpr bool decode_escapes = true;
+};
+
+/// Strings and names have to be valid UTF-8, otherwise invalid_utf8 is reported. Sequences split across input buffers
+/// are continued with the next buffer.
+struct validate_utf8_traits : default_traits
+{
+    static constexpr bool validate_utf8 = true;
+};
+
+namespace detail
+{
+template <typename Traits, typename = void>
+struct has_raw_numbers : std::false_type
+{
+};
+template <typename Traits>
+struct has_raw_numbers<Traits, std::void_t<decltype(Traits::raw_numbers)>> : std::bool_constant<Traits::raw_numbers>
+{
+};
+template <typename Traits, typename = void>
+struct has_multi_document : std::false_type
+{
+};
+template <typename Traits>
+struct has_multi_document<Traits, std::void_t<decltype(Traits::multi_document)>> : std::bool_constant<Traits::multi_document>
+{
+};
+template <typename Traits, typename = void>
+struct has_name_hashes : std::false_type
+{
+};
+template <typename Traits>
+struct has_name_hashes<Traits, std::void_t<decltype(Traits::name_hashes)>> : std::bool_constant<Traits::name_hashes>
+{
+};
+template <typename Traits, typename = void>
+struct has_decode_escapes : std::false_type
+{
+};
+template <typename Traits>
+struct has_decode_escapes<Traits, std::void_t<decltype(Traits::decode_escapes)>> : std::bool_constant<Traits::decode_escapes>
+{
+};
+template <typename Traits, typename = void>
+struct has_validate_utf8 : std::false_type
+{
+};
+template <typename Traits>
+struct has_validate_utf8<Traits, std::void_t<decltype(Traits::validate_utf8)>> : std::bool_constant<Traits::validate_utf8>
+{
+};
+}  // namespace detail
+
 }  // namespace async_json
 
 #endif
@@ -160,12 +160,14 @@ void basic_is_path<Traits, IT>::setup_sm()
             a::on_start[match_begin]            = in_path,        //
             a::a_start / put_array              = expect_object,  // change
             a::str_start                        = consume_value,  //
+            a::num_start                        = consume_value,  //
             hsm::any[is_value] / remove_element = in_path),       //
         expect_object_or_done,                                    //
         expect_object_or_done[last_element] = exp_value,          //
         expect_object_or_done               = expect_object,      //
         consume_value(                                            //
-            a::str_cont = consume_value, a::str_end / remove_element = in_path),
+            a::str_cont = consume_value, a::str_end / remove_element = in_path,  //
+            a::num_cont = consume_value, a::num_end / remove_element = in_path),
         consume_array(                                                                       //
             a::o_start                = consume_array_nested,                                //
             a::a_start                = consume_array_nested,                                //
@@ -203,6 +205,8 @@ void basic_is_path<Traits, IT>::setup_sm()
             a::a_start                = value_or_empty_struct,                               //
             a::str_start              = exp_value,                                           //
             a::str_cont               = exp_value,                                           //
+            a::num_start              = exp_value,                                           //
+            a::num_cont               = exp_value,                                           //
             hsm::any / remove_element = in_path,                                             //
             value_or_empty_struct(                                                           //
                 a::o_start / inc_off_path_counter   = value_or_empty_struct,                 //
@@ -229,6 +233,8 @@ void basic_is_path<Traits, IT>::setup_sm()
                    path_sm.current_state_id() == path_sm.get_state_id(value_or_empty_struct) ||
                    path_sm.current_state_id() == path_sm.get_state_id(object_value_nested);
         path_sm.process_event(static_cast<typename decltype(path_sm)::event_id>(ev.as_event_id()), *this);
+        // nested objects and arrays of the member value are only counted in off_path, they do not affect the match
+        off_path_value = path_sm.current_state_id() == path_sm.get_state_id(off_path);
         return ret;
     };
 }
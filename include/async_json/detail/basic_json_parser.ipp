@@ -30,6 +30,10 @@ constexpr hsm::event<struct f_char>          f;
 constexpr hsm::event<struct n_char>          n;
 constexpr hsm::event<struct esc_char>        escape;
 constexpr hsm::event<struct end_of_input>    eoi;
+constexpr hsm::event<struct true_keyword>    true_kw;
+constexpr hsm::event<struct false_keyword>   false_kw;
+constexpr hsm::event<struct null_keyword>    null_kw;
+constexpr hsm::event<struct skipped_value>   skipped;
 
 constexpr hsm::state_ref<struct done_s>          done;
 constexpr hsm::state_ref<struct error_s>         error;
@@ -65,20 +69,374 @@ constexpr hsm::state_ref<struct array_object_br_close_s>  array_object_br_close;
 constexpr hsm::state_ref<struct array_object_idx_close_s> array_object_idx_close;
 constexpr hsm::state_ref<struct array_object_s>           array_object;
 
+// Event ids of the character events, they are registered in this order first in the parser state machine
+enum class char_class : std::uint8_t
+{
+    other = 1,
+    digit,
+    quot,
+    colon,
+    comma,
+    dot,
+    exponent,
+    plus,
+    minus,
+    br_open,
+    br_close,
+    idx_open,
+    idx_close,
+    whitespace,
+    t,
+    f,
+    n,
+    escape
+};
+
+constexpr std::array<char_class, 256> make_char_class_table() noexcept
+{
+    std::array<char_class, 256> table{};
+    for (auto& entry : table) entry = char_class::other;
+    for (unsigned char c = '0'; c <= '9'; ++c) table[c] = char_class::digit;
+    table[static_cast<unsigned char>('"')]  = char_class::quot;
+    table[static_cast<unsigned char>(':')]  = char_class::colon;
+    table[static_cast<unsigned char>(',')]  = char_class::comma;
+    table[static_cast<unsigned char>('.')]  = char_class::dot;
+    table[static_cast<unsigned char>('e')]  = char_class::exponent;
+    table[static_cast<unsigned char>('E')]  = char_class::exponent;
+    table[static_cast<unsigned char>('+')]  = char_class::plus;
+    table[static_cast<unsigned char>('-')]  = char_class::minus;
+    table[static_cast<unsigned char>('{')]  = char_class::br_open;
+    table[static_cast<unsigned char>('}')]  = char_class::br_close;
+    table[static_cast<unsigned char>('[')]  = char_class::idx_open;
+    table[static_cast<unsigned char>(']')]  = char_class::idx_close;
+    table[static_cast<unsigned char>(' ')]  = char_class::whitespace;
+    table[static_cast<unsigned char>('\b')] = char_class::whitespace;
+    table[static_cast<unsigned char>('\t')] = char_class::whitespace;
+    table[static_cast<unsigned char>('\r')] = char_class::whitespace;
+    table[static_cast<unsigned char>('\n')] = char_class::whitespace;
+    table[static_cast<unsigned char>('t')]  = char_class::t;
+    table[static_cast<unsigned char>('f')]  = char_class::f;
+    table[static_cast<unsigned char>('n')]  = char_class::n;
+    table[static_cast<unsigned char>('\\')] = char_class::escape;
+    return table;
+}
+
+constexpr auto char_class_table = make_char_class_table();
+
 template <error_cause err, typename S>
 constexpr auto error_action()
 {
     return [](S& self) { (*self.callback_handler())(typename S::event_value(async_json::saj_event::parse_error, err)); };
 }
+
+// The fused_tag interpreter: the parser state machine flattened into one state x event table. Each cell holds the
+// action and the target state, so a byte costs one table load and one jump through the action switch. Child states
+// carry the transitions of their parents, guards are evaluated within the actions.
+enum class fused_event : std::uint8_t
+{
+    eoi = cast(char_class::escape) + 1,
+    true_kw,
+    false_kw,
+    null_kw,
+    skipped,
+    count
+};
+
+enum class fused_state : std::uint8_t
+{
+    done,
+    error,
+    json,
+    json_in_array,
+    int_number,
+    int_number_ws,
+    fraction_number,
+    exp,
+    exp_sign,
+    string_start_cont,
+    string_start_cont_esc,
+    string_n,
+    string_n_esc,
+    string_n_cont,
+    string_n_cont_esc,
+    expect_quot,
+    name_start_cont,
+    name_start_cont_esc,
+    name_n,
+    name_n_esc,
+    name_n_cont,
+    name_n_cont_esc,
+    expect_colon,
+    keyword,
+    array_object,
+    array_object_comma,
+    count,
+    // targets that are resolved on entry by the guards of the initial transitions, never current
+    array_object_br_close = count,
+    array_object_idx_close,
+    stay  ///< internal transition
+};
+
+enum class fused_op : std::uint8_t
+{
+    none,
+    unexpected_character,
+    invalid_number,
+    member_expected,
+    colon_expected,
+    comma_expected,
+    setup_true,
+    setup_false,
+    setup_null,
+    emit_true,
+    emit_false,
+    emit_null,
+    push_object,
+    push_array,
+    pop_array,
+    pop_empty_object,
+    begin_number,
+    negate_num,
+    add_digit_num,
+    add_digit_fraction,
+    add_digit_exp,
+    negate_exp,
+    emit_number,
+    emit_fraction,
+    emit_exp_fraction,
+    emit_number_part,
+    mem_add_ch,
+    mem_add_esc,
+    mem_n_str,
+    mem_n_esc,
+    str_first_last,
+    str_n_last,
+    str_part_first,
+    str_part_n,
+    name_first_last,
+    name_n_last,
+    name_part_first,
+    name_part_n,
+    keyword_char
+};
+
+struct fused_cell
+{
+    fused_op    op{fused_op::none};
+    fused_state next{fused_state::stay};
+};
+
+constexpr std::size_t fused_event_count = cast(fused_event::count);
+constexpr std::size_t fused_state_count = cast(fused_state::count);
+using fused_row                         = std::array<fused_cell, fused_event_count>;
+
+constexpr auto make_fused_table() noexcept
+{
+    using s = fused_state;
+    using o = fused_op;
+    using c = char_class;
+    using e = fused_event;
+    std::array<fused_row, fused_state_count> table{};
+    auto const on  = [&table](s state, auto ev, o op, s next) { table[cast(state)][cast(ev)] = fused_cell{op, next}; };
+    auto const any = [&table](s state, o op, s next)
+    {
+        for (auto ev = cast(c::other); ev <= cast(c::escape); ++ev) table[cast(state)][ev] = fused_cell{op, next};
+    };
+    auto const inherit = [&table](s state, s parent) { table[cast(state)] = table[cast(parent)]; };
+
+    any(s::json, o::unexpected_character, s::error);
+    on(s::json, c::whitespace, o::none, s::stay);
+    on(s::json, c::n, o::setup_null, s::keyword);
+    on(s::json, c::f, o::setup_false, s::keyword);
+    on(s::json, c::t, o::setup_true, s::keyword);
+    on(s::json, e::true_kw, o::emit_true, s::array_object);
+    on(s::json, e::false_kw, o::emit_false, s::array_object);
+    on(s::json, e::null_kw, o::emit_null, s::array_object);
+    on(s::json, e::skipped, o::none, s::array_object);
+    on(s::json, c::br_open, o::push_object, s::expect_quot);
+    on(s::json, c::idx_open, o::push_array, s::json_in_array);
+    on(s::json, c::quot, o::none, s::string_start_cont);
+    on(s::json, c::digit, o::begin_number, s::int_number);
+    on(s::json, c::minus, o::negate_num, s::int_number_ws);
+    on(s::json, e::eoi, o::none, s::stay);
+    inherit(s::json_in_array, s::json);
+    on(s::json_in_array, c::idx_close, o::pop_array, s::array_object);
+
+    any(s::int_number, o::invalid_number, s::error);
+    on(s::int_number, c::digit, o::add_digit_num, s::stay);
+    on(s::int_number, c::dot, o::none, s::fraction_number);
+    on(s::int_number, c::exponent, o::none, s::exp_sign);
+    on(s::int_number, c::comma, o::emit_number, s::array_object_comma);
+    on(s::int_number, c::br_close, o::emit_number, s::array_object_br_close);
+    on(s::int_number, c::idx_close, o::emit_number, s::array_object_idx_close);
+    on(s::int_number, c::whitespace, o::emit_number, s::array_object);
+    on(s::int_number, e::eoi, o::emit_number_part, s::stay);
+    inherit(s::int_number_ws, s::int_number);
+    on(s::int_number_ws, c::whitespace, o::none, s::stay);
+    on(s::int_number_ws, c::digit, o::add_digit_num, s::int_number);
+
+    any(s::fraction_number, o::invalid_number, s::error);
+    on(s::fraction_number, c::digit, o::add_digit_fraction, s::stay);
+    on(s::fraction_number, c::exponent, o::none, s::exp_sign);
+    on(s::fraction_number, c::comma, o::emit_fraction, s::array_object_comma);
+    on(s::fraction_number, c::br_close, o::emit_fraction, s::array_object_br_close);
+    on(s::fraction_number, c::idx_close, o::emit_fraction, s::array_object_idx_close);
+    on(s::fraction_number, c::whitespace, o::emit_fraction, s::array_object);
+    on(s::fraction_number, e::eoi, o::emit_number_part, s::stay);
+
+    any(s::exp, o::invalid_number, s::error);
+    on(s::exp, c::digit, o::add_digit_exp, s::stay);
+    on(s::exp, c::comma, o::emit_exp_fraction, s::array_object_comma);
+    on(s::exp, c::br_close, o::emit_exp_fraction, s::array_object_br_close);
+    on(s::exp, c::idx_close, o::emit_exp_fraction, s::array_object_idx_close);
+    on(s::exp, c::whitespace, o::emit_exp_fraction, s::array_object);
+    on(s::exp, e::eoi, o::emit_number_part, s::stay);
+    inherit(s::exp_sign, s::exp);
+    any(s::exp_sign, o::invalid_number, s::error);
+    on(s::exp_sign, c::minus, o::negate_exp, s::exp);
+    on(s::exp_sign, c::plus, o::none, s::exp);
+    on(s::exp_sign, c::digit, o::add_digit_exp, s::exp);
+
+    // strings and names only differ in their actions and the state after the closing quote
+    auto const text = [&](s start_cont, s start_cont_esc, s n, s n_esc, s n_cont, s n_cont_esc, bool name)
+    {
+        auto const after = name ? s::expect_colon : s::array_object;
+        any(start_cont, o::mem_add_ch, start_cont);
+        on(start_cont, c::escape, o::mem_add_esc, start_cont_esc);
+        on(start_cont, c::quot, name ? o::name_first_last : o::str_first_last, after);
+        on(start_cont, e::eoi, name ? o::name_part_first : o::str_part_first, n);
+        any(start_cont_esc, o::mem_add_ch, start_cont);
+        on(start_cont_esc, e::eoi, name ? o::name_part_first : o::str_part_first, n_esc);
+        any(n, o::mem_n_str, n_cont);
+        on(n, c::quot, name ? o::name_n_last : o::str_n_last, after);
+        on(n, c::escape, o::mem_n_esc, n_cont_esc);
+        any(n_esc, o::mem_n_str, n_cont);
+        any(n_cont, o::mem_add_ch, n_cont);
+        on(n_cont, c::escape, o::mem_add_esc, n_cont_esc);
+        on(n_cont, c::quot, name ? o::name_n_last : o::str_n_last, after);
+        on(n_cont, e::eoi, name ? o::name_part_n : o::str_part_n, n);
+        any(n_cont_esc, o::mem_add_ch, n_cont);
+        on(n_cont_esc, e::eoi, name ? o::name_part_n : o::str_part_n, n_esc);
+    };
+    text(s::string_start_cont, s::string_start_cont_esc, s::string_n, s::string_n_esc, s::string_n_cont, s::string_n_cont_esc, false);
+    text(s::name_start_cont, s::name_start_cont_esc, s::name_n, s::name_n_esc, s::name_n_cont, s::name_n_cont_esc, true);
+
+    any(s::expect_quot, o::member_expected, s::error);
+    on(s::expect_quot, c::whitespace, o::none, s::stay);
+    on(s::expect_quot, e::eoi, o::none, s::stay);
+    on(s::expect_quot, c::quot, o::none, s::name_start_cont);
+    on(s::expect_quot, c::br_close, o::pop_empty_object, s::array_object);
+
+    any(s::expect_colon, o::colon_expected, s::error);
+    on(s::expect_colon, c::whitespace, o::none, s::stay);
+    on(s::expect_colon, c::colon, o::none, s::json);
+    on(s::expect_colon, e::eoi, o::none, s::stay);
+
+    any(s::keyword, o::keyword_char, s::keyword);
+    on(s::keyword, e::eoi, o::none, s::stay);
+
+    any(s::array_object, o::comma_expected, s::error);
+    on(s::array_object, c::whitespace, o::none, s::stay);
+    on(s::array_object, e::eoi, o::none, s::stay);
+    on(s::array_object, c::comma, o::none, s::array_object_comma);
+    on(s::array_object, c::br_close, o::none, s::array_object_br_close);
+    on(s::array_object, c::idx_close, o::none, s::array_object_idx_close);
+    inherit(s::array_object_comma, s::array_object);
+    return table;
+}
+
+constexpr auto fused_table = make_fused_table();
+
+template <typename S>
+constexpr fused_state fused_state_of = fused_state::stay;
+template <>
+constexpr fused_state fused_state_of<done_s> = fused_state::done;
+template <>
+constexpr fused_state fused_state_of<error_s> = fused_state::error;
+template <>
+constexpr fused_state fused_state_of<json_s> = fused_state::json;
+template <>
+constexpr fused_state fused_state_of<json_in_array_s> = fused_state::json_in_array;
+template <>
+constexpr fused_state fused_state_of<int_number_s> = fused_state::int_number;
+template <>
+constexpr fused_state fused_state_of<fraction_number_s> = fused_state::fraction_number;
+template <>
+constexpr fused_state fused_state_of<exponent_s> = fused_state::exp;
+template <>
+constexpr fused_state fused_state_of<string_start_cont_s> = fused_state::string_start_cont;
+template <>
+constexpr fused_state fused_state_of<string_n_cont_s> = fused_state::string_n_cont;
+template <>
+constexpr fused_state fused_state_of<name_start_cont_s> = fused_state::name_start_cont;
+template <>
+constexpr fused_state fused_state_of<name_n_cont_s> = fused_state::name_n_cont;
+template <>
+constexpr fused_state fused_state_of<expect_quot_s> = fused_state::expect_quot;
+template <>
+constexpr fused_state fused_state_of<expect_colon_s> = fused_state::expect_colon;
+template <>
+constexpr fused_state fused_state_of<array_object_s> = fused_state::array_object;
+
+template <typename E>
+constexpr fused_event fused_event_of = fused_event::count;
+template <>
+constexpr fused_event fused_event_of<end_of_input> = fused_event::eoi;
+template <>
+constexpr fused_event fused_event_of<true_keyword> = fused_event::true_kw;
+template <>
+constexpr fused_event fused_event_of<false_keyword> = fused_event::false_kw;
+template <>
+constexpr fused_event fused_event_of<null_keyword> = fused_event::null_kw;
+template <>
+constexpr fused_event fused_event_of<skipped_value> = fused_event::skipped;
+
+// Same interface as the hsm state machines as far as the parser uses it. Actions is called with the action and the
+// target state of the cell and returns the state that is entered, or fused_state::stay.
+template <typename S, typename Actions>
+class fused_sm
+{
+   public:
+    enum class event_id : std::uint8_t
+    {
+    };
+
+    explicit fused_sm(Actions a) : actions(a) {}
+
+    void start(S&) noexcept { state = fused_state::json; }
+    void process_event(event_id ev, S& self)
+    {
+        auto const cell = fused_table[cast(state)][cast(ev)];
+        auto const next = actions(cell.op, cell.next, self);
+        if (next != fused_state::stay) state = next;
+    }
+    template <typename E>
+    void process_event(hsm::event<E>, S& self)
+    {
+        static_assert(fused_event_of<E> != fused_event::count, "event is not handled by the fused table");
+        process_event(static_cast<event_id>(cast(fused_event_of<E>)), self);
+    }
+    fused_state current_state_id() const noexcept { return state; }
+    template <typename T>
+    static constexpr fused_state get_state_id(hsm::state_ref<T>) noexcept
+    {
+        static_assert(fused_state_of<T> != fused_state::stay, "state is not tracked by the fused table");
+        return fused_state_of<T>;
+    }
+
+   private:
+    Actions     actions;
+    fused_state state{fused_state::json};
+};
 }  // namespace detail
 
 template <typename Handler, typename Traits, typename IT>
 auto basic_json_parser<Handler, Traits, IT>::get_fraction_we() -> float_t
 {
-    float_t ret = get_fraction() * static_cast<float_t>(std::pow(10, exp_sign * static_cast<integer_t>(exp_number)));
-    exp_number  = 0;
-    exp_sign    = 1;
-    return ret;
+    auto const exp10 = exp_sign * static_cast<std::int64_t>(exp_number);
+    exp_number       = 0;
+    exp_sign         = 1;
+    return get_float(exp10);
 }
 
 template <typename Handler, typename Traits, typename IT>
@@ -87,17 +445,23 @@ auto basic_json_parser<Handler, Traits, IT>::get_number() -> integer_t
     integer_t ret = num_sign * static_cast<integer_t>(int_number);
     int_number    = 0;
     num_sign      = 1;
+    decimal.clear();
     return ret;
 }
+
 template <typename Handler, typename Traits, typename IT>
 auto basic_json_parser<Handler, Traits, IT>::get_fraction() -> float_t
 {
-    float_t ret =
-        num_sign * (static_cast<integer_t>(int_number) + static_cast<float_t>(fraction) / static_cast<float_t>(std::pow(10, frac_digits)));
+    return get_float(0);
+}
+
+template <typename Handler, typename Traits, typename IT>
+auto basic_json_parser<Handler, Traits, IT>::get_float(std::int64_t exp10) -> float_t
+{
+    float_t ret = decimal.convert<float_t>(num_sign < 0, exp10);
     int_number  = 0;
     num_sign    = 1;
-    fraction    = 0;
-    frac_digits = 0;
+    decimal.clear();
     return ret;
 }
 template <typename Handler, typename Traits, typename IT>
@@ -115,23 +479,82 @@ auto basic_json_parser<Handler, Traits, IT>::setup_sm() -> void
     auto kw_consume_char     = [](self_t& self) { ++self.kw_state.pos; };
     auto kw_complete_keyword = [](self_t& self)
     {
-        if (self.kw_state.kw == sv_t{"null"})
-            self.cbs(event_value());
-        else if (self.kw_state.kw == sv_t{"true"})
-            self.cbs(event_value(saj_event::boolean_value, true));
-        else
-            self.cbs(event_value(saj_event::boolean_value, false));
+        switch (self.kw_state.kw[0])
+        {
+            case 'n': self.cbs(event_value()); break;
+            case 't': self.cbs(event_value(saj_event::boolean_value, true)); break;
+            default: self.cbs(event_value(saj_event::boolean_value, false)); break;
+        }
     };
+    auto emit_true  = [](self_t& self) { self.cbs(event_value(saj_event::boolean_value, true)); };
+    auto emit_false = [](self_t& self) { self.cbs(event_value(saj_event::boolean_value, false)); };
+    auto emit_null  = [](self_t& self) { self.cbs(event_value()); };
 
-    auto negate_exp         = [](self_t& self) { self.exp_sign = -1; };
-    auto negate_num         = [](self_t& self) { self.num_sign = -1; };
-    auto add_digit_num      = [](self_t& self) { self.int_number = self.int_number * 10 + (self.cur - '0'); };
-    auto add_digit_exp      = [](self_t& self) { self.exp_number = self.exp_number * 10 + (self.cur - '0'); };
-    auto add_digit_fraction = [](self_t& self) { ++self.frac_digits, self.fraction = self.fraction * 10 + (self.cur - '0'); };
+    // in raw number mode digits are not accumulated, the number is reported as a span of the input instead
+    auto negate_exp = [](self_t& self)
+    {
+        if constexpr (!raw_numbers) self.exp_sign = -1;
+    };
+    auto negate_num = [](self_t& self)
+    {
+        if constexpr (raw_numbers)
+            self.number_begin = self.current_input_buffer.data();
+        else
+            self.num_sign = -1;
+    };
+    auto add_digit_num = [](self_t& self)
+    {
+        if constexpr (!raw_numbers)
+        {
+            self.int_number = self.int_number * 10 + static_cast<unsigned>(self.cur - '0');
+            self.decimal.add_digit(static_cast<unsigned>(self.cur - '0'), false);
+        }
+    };
+    auto begin_number = [](self_t& self)
+    {
+        if constexpr (raw_numbers)
+            self.number_begin = self.current_input_buffer.data();
+        else
+        {
+            self.int_number = static_cast<unsigned>(self.cur - '0');
+            self.decimal.add_digit(static_cast<unsigned>(self.cur - '0'), false);
+        }
+    };
+    auto add_digit_exp = [](self_t& self)
+    {
+        if constexpr (!raw_numbers)
+            self.exp_number = std::min(self.exp_number * 10 + static_cast<unsigned>(self.cur - '0'), detail::exponent_limit);
+    };
+    auto add_digit_fraction = [](self_t& self)
+    {
+        if constexpr (!raw_numbers) self.decimal.add_digit(static_cast<unsigned>(self.cur - '0'), true);
+    };
 
-    auto emit_number       = [](self_t& self) { self.cbs(event_value(saj_event::integer_value, self.get_number())); };
-    auto emit_fraction     = [](self_t& self) { self.cbs(event_value(saj_event::float_value, self.get_fraction())); };
-    auto emit_exp_fraction = [](self_t& self) { self.cbs(event_value(saj_event::float_value, self.get_fraction_we())); };
+    auto emit_number = [](self_t& self)
+    {
+        if constexpr (raw_numbers)
+            self.emit_number_span(true);
+        else
+            self.cbs(event_value(saj_event::integer_value, self.get_number()));
+    };
+    auto emit_fraction = [](self_t& self)
+    {
+        if constexpr (raw_numbers)
+            self.emit_number_span(true);
+        else
+            self.cbs(event_value(saj_event::float_value, self.get_fraction()));
+    };
+    auto emit_exp_fraction = [](self_t& self)
+    {
+        if constexpr (raw_numbers)
+            self.emit_number_span(true);
+        else
+            self.cbs(event_value(saj_event::float_value, self.get_fraction_we()));
+    };
+    auto emit_number_part = [](self_t& self)
+    {
+        if constexpr (raw_numbers) self.emit_number_span(false);
+    };
     auto push_object       = [](self_t& self)
     {
         self.cbs(event_value(saj_event::object_start));
@@ -152,35 +575,46 @@ auto basic_json_parser<Handler, Traits, IT>::setup_sm() -> void
         self.cbs(event_value(saj_event::array_end));
         self.state_stack.pop_back();
     };
+    // with decode_escapes strings and names are collected until the closing quote and reported in one event
     auto emit_name_first = [](self_t& self)
     {
-        self.cbs(event_value(saj_event::object_name_start, self.parsed_view));
-        self.parsed_view = sv_t(nullptr, 0);
+        if constexpr (decode_escapes)
+            self.buffer_text_part();
+        else
+            self.emit_name_part(saj_event::object_name_start);
     };
 
     auto emit_name_first_last = [](self_t& self)
     {
-        self.cbs(event_value(saj_event::object_name_start, self.parsed_view));
-        self.parsed_view = sv_t(nullptr, 0);
-        self.cbs(event_value(saj_event::object_name_end));
+        self.emit_name_part(saj_event::object_name_start);
+        self.emit_name_end();
     };
 
     auto emit_name_n = [](self_t& self)
     {
-        if (self.parsed_view.size()) self.cbs(event_value(saj_event::object_name_cont, self.parsed_view));
+        if constexpr (decode_escapes)
+            self.buffer_text_part();
+        else if (self.parsed_view.size())
+            self.emit_name_part(saj_event::object_name_cont);
         self.parsed_view = sv_t(nullptr, 0);
     };
 
     auto emit_name_n_last = [](self_t& self)
     {
-        if (self.parsed_view.size()) self.cbs(event_value(saj_event::object_name_cont, self.parsed_view));
+        if constexpr (decode_escapes)
+            self.emit_name_part(saj_event::object_name_start);
+        else if (self.parsed_view.size())
+            self.emit_name_part(saj_event::object_name_cont);
         self.parsed_view = sv_t(nullptr, 0);
-        self.cbs(event_value(saj_event::object_name_end));
+        self.emit_name_end();
     };
 
     auto emit_str_first = [](self_t& self)
     {
-        self.cbs(event_value(saj_event::string_value_start, self.parsed_view));
+        if constexpr (decode_escapes)
+            self.buffer_text_part();
+        else
+            self.cbs(event_value(saj_event::string_value_start, self.parsed_view));
         self.parsed_view = sv_t(nullptr, 0);
     };
 
@@ -193,18 +627,31 @@ auto basic_json_parser<Handler, Traits, IT>::setup_sm() -> void
 
     auto emit_str_n = [](self_t& self)
     {
-        if (self.parsed_view.size()) self.cbs(event_value(saj_event::string_value_cont, self.parsed_view));
+        if constexpr (decode_escapes)
+            self.buffer_text_part();
+        else if (self.parsed_view.size())
+            self.cbs(event_value(saj_event::string_value_cont, self.parsed_view));
         self.parsed_view = sv_t(nullptr, 0);
     };
 
     auto emit_str_n_last = [](self_t& self)
     {
-        if (self.parsed_view.size()) self.cbs(event_value(saj_event::string_value_cont, self.parsed_view));
+        if constexpr (decode_escapes)
+            self.cbs(event_value(saj_event::string_value_start, self.parsed_view));
+        else if (self.parsed_view.size())
+            self.cbs(event_value(saj_event::string_value_cont, self.parsed_view));
         self.parsed_view = sv_t(nullptr, 0);
         self.cbs(event_value(saj_event::string_value_end));
     };
 
-    auto stack_empty        = [](self_t& self) { return self.state_stack.size() == 0; };
+    // checks the part of a string or name at the end of the buffer, only fails with validate_utf8
+    auto invalid_part = [](self_t& self) { return !self.check_text_part(); };
+    // checks the last part and replaces parsed_view with the decoded string or name, see finish_text
+    auto invalid_text      = [](self_t& self) { return !self.finish_text(); };
+    auto report_text_error = [](self_t& self) { self.cbs(event_value(saj_event::parse_error, self.text_error)); };
+
+    auto stack_empty        = [](self_t& self) { return self.state_stack.empty(); };
+    auto stack_full         = [](self_t& self) { return self.state_stack.full(); };
     auto no_object_on_stack = [](self_t& self) { return self.state_stack.size() == 0 || self.state_stack.back() != 0; };
     auto object_on_stack    = [](self_t& self) { return self.state_stack.size() && self.state_stack.back() == 0; };
     auto no_array_on_stack  = [](self_t& self) { return self.state_stack.size() == 0 || self.state_stack.back() != 1; };
@@ -215,16 +662,151 @@ auto basic_json_parser<Handler, Traits, IT>::setup_sm() -> void
         self.parsed_view =
             sv_t(self.parsed_view.empty() ? self.current_input_buffer.begin() : self.parsed_view.begin(), self.parsed_view.size() + 1);
     };
+    auto mem_n_esc = [](self_t& self)
+    {
+        if constexpr (decode_escapes) self.text_escaped = true;
+        self.parsed_view = sv_t(self.current_input_buffer.begin(), 1);
+    };
+    auto mem_add_esc = [](self_t& self)
+    {
+        if constexpr (decode_escapes) self.text_escaped = true;
+        self.parsed_view =
+            sv_t(self.parsed_view.empty() ? self.current_input_buffer.begin() : self.parsed_view.begin(), self.parsed_view.size() + 1);
+    };
     auto is_empty = [](self_t& self) { return self.parsed_view.empty(); };
 
     using namespace async_json::detail;
-    auto select_sm = []<typename... Ts>(Ts&&... p) noexcept
+    // the actions of fused_table, guards and the initial transitions of the entered state are resolved here
+    auto fused_actions = [=](fused_op op, fused_state next, self_t& self) -> fused_state
+    {
+        auto const fail = [&self](error_cause cause)
+        {
+            self.cbs(event_value(saj_event::parse_error, cause));
+            return fused_state::error;
+        };
+        switch (op)
+        {
+            case fused_op::none: break;
+            case fused_op::unexpected_character: return fail(unexpected_character);
+            case fused_op::invalid_number: return fail(invalid_number);
+            case fused_op::member_expected: return fail(member_exp);
+            case fused_op::colon_expected: return fail(colon_exp);
+            case fused_op::comma_expected: return fail(comma_expected);
+            case fused_op::setup_true: setup_true(self); break;
+            case fused_op::setup_false: setup_false(self); break;
+            case fused_op::setup_null: setup_null(self); break;
+            case fused_op::emit_true: emit_true(self); break;
+            case fused_op::emit_false: emit_false(self); break;
+            case fused_op::emit_null: emit_null(self); break;
+            case fused_op::push_object:
+                if (stack_full(self)) return fail(nesting_too_deep);
+                push_object(self);
+                break;
+            case fused_op::push_array:
+                if (stack_full(self)) return fail(nesting_too_deep);
+                push_array(self);
+                break;
+            case fused_op::pop_array: pop_array(self); break;
+            case fused_op::pop_empty_object:
+                if (!object_on_stack(self)) return fail(member_exp);
+                pop_object(self);
+                break;
+            case fused_op::begin_number: begin_number(self); break;
+            case fused_op::negate_num: negate_num(self); break;
+            case fused_op::add_digit_num: add_digit_num(self); break;
+            case fused_op::add_digit_fraction: add_digit_fraction(self); break;
+            case fused_op::add_digit_exp: add_digit_exp(self); break;
+            case fused_op::negate_exp: negate_exp(self); break;
+            case fused_op::emit_number: emit_number(self); break;
+            case fused_op::emit_fraction: emit_fraction(self); break;
+            case fused_op::emit_exp_fraction: emit_exp_fraction(self); break;
+            case fused_op::emit_number_part: emit_number_part(self); break;
+            case fused_op::mem_add_ch: mem_add_ch(self); break;
+            case fused_op::mem_add_esc: mem_add_esc(self); break;
+            case fused_op::mem_n_str: mem_n_str(self); break;
+            case fused_op::mem_n_esc: mem_n_esc(self); break;
+            case fused_op::str_first_last:
+            case fused_op::str_n_last:
+            case fused_op::name_first_last:
+            case fused_op::name_n_last:
+                if (invalid_text(self))
+                {
+                    report_text_error(self);
+                    return fused_state::error;
+                }
+                if (op == fused_op::str_first_last)
+                    emit_str_first_last(self);
+                else if (op == fused_op::str_n_last)
+                    emit_str_n_last(self);
+                else if (op == fused_op::name_first_last)
+                    emit_name_first_last(self);
+                else
+                    emit_name_n_last(self);
+                break;
+            case fused_op::str_part_first:
+            case fused_op::str_part_n:
+            case fused_op::name_part_first:
+            case fused_op::name_part_n:
+                if (is_empty(self)) return fused_state::stay;
+                if (invalid_part(self))
+                {
+                    report_text_error(self);
+                    return fused_state::error;
+                }
+                if (op == fused_op::str_part_first)
+                    emit_str_first(self);
+                else if (op == fused_op::str_part_n)
+                    emit_str_n(self);
+                else if (op == fused_op::name_part_first)
+                    emit_name_first(self);
+                else
+                    emit_name_n(self);
+                break;
+            case fused_op::keyword_char:
+                if (kw_consume(self))
+                    kw_consume_char(self);
+                else if (kw_complete(self))
+                {
+                    kw_complete_keyword(self);
+                    next = fused_state::array_object;
+                }
+                else
+                    return fail(wrong_keyword_character);
+                break;
+        }
+        for (;;)
+        {
+            switch (next)
+            {
+                case fused_state::array_object: return stack_empty(self) ? fused_state::done : next;
+                case fused_state::array_object_comma:
+                    if (object_on_stack(self)) return fused_state::expect_quot;
+                    if (array_on_stack(self)) return fused_state::json;
+                    return next;
+                case fused_state::array_object_br_close:
+                    if (no_object_on_stack(self)) return fail(mismatched_brace);
+                    pop_object(self);
+                    next = fused_state::array_object;
+                    break;
+                case fused_state::array_object_idx_close:
+                    if (no_array_on_stack(self)) return fail(mismatched_array);
+                    pop_array(self);
+                    next = fused_state::array_object;
+                    break;
+                default: return next;
+            }
+        }
+    };
+    auto select_sm = [&fused_actions]<typename... Ts>(Ts&&... p) noexcept
     {
         if constexpr (std::is_same_v<IT, table_tag>) { return hsm::create_state_machine<self_t>(std::forward<Ts>(p)...); }
+        else if constexpr (std::is_same_v<IT, fused_tag>) { return fused_sm<self_t, decltype(fused_actions)>(fused_actions); }
         else { return hsm::create_unrolled_sm<self_t>(std::forward<Ts>(p)...); }
     };
     auto sm = select_sm(  //
         ch,               // catch all event
+        digit, quot, colon, comma, dot, exponent, plus, minus, br_open, br_close, idx_open, idx_close, whitespace, t, f, n,
+        escape,  // registered first in the order of char_class
         done,
         error,                                      //
         hsm::initial = json_state,                  //
@@ -233,10 +815,16 @@ auto basic_json_parser<Handler, Traits, IT>::setup_sm() -> void
             n / setup_null        = keyword,
             f / setup_false       = keyword,              //
             t / setup_true        = keyword,              //
+            true_kw / emit_true   = array_object,         //
+            false_kw / emit_false = array_object,         //
+            null_kw / emit_null   = array_object,         //
+            skipped               = array_object,         //
+            br_open[stack_full] / detail::error_action<nesting_too_deep, self_t>()  = error,  //
+            idx_open[stack_full] / detail::error_action<nesting_too_deep, self_t>() = error,  //
             br_open / push_object = member,               //
             idx_open / push_array = json_state_in_array,  //
             quot                  = string_start_cont,    //
-            digit / add_digit_num = int_number_state,     //
+            digit / begin_number  = int_number_state,     //
             minus / negate_num    = int_number_ws,        //
             eoi                   = hsm::internal,        //
             json_state_in_array(                          //
@@ -253,7 +841,7 @@ auto basic_json_parser<Handler, Traits, IT>::setup_sm() -> void
             br_close / emit_number                                    = array_object_br_close,   //
             idx_close / emit_number                                   = array_object_idx_close,  //
             whitespace / emit_number                                  = array_object,            //
-            eoi                                                       = hsm::internal,           //
+            eoi / emit_number_part                                    = hsm::internal,           //
             hsm::any / detail::error_action<invalid_number, self_t>() = error),
         fraction_number(                                                                         //
             digit / add_digit_fraction                                = hsm::internal,           //
@@ -262,46 +850,53 @@ auto basic_json_parser<Handler, Traits, IT>::setup_sm() -> void
             br_close / emit_fraction                                  = array_object_br_close,   //
             idx_close / emit_fraction                                 = array_object_idx_close,  //
             whitespace / emit_fraction                                = array_object,            //
-            eoi                                                       = hsm::internal,           //
+            eoi / emit_number_part                                    = hsm::internal,           //
             hsm::any / detail::error_action<invalid_number, self_t>() = error),
         exp_state(                                                                          //
             digit / add_digit_exp = hsm::internal,                                          //
             exp_sign_state(                                                                 //
                 minus / negate_exp                                        = exp_state,      //
-                plus / negate_exp                                         = exp_state,      //
+                plus                                                      = exp_state,      //
                 digit / add_digit_exp                                     = exp_state,      //
-                eoi                                                       = hsm::internal,  //
+                eoi / emit_number_part                                    = hsm::internal,  //
                 hsm::any / detail::error_action<invalid_number, self_t>() = error),
             comma / emit_exp_fraction                                 = array_object_comma,      //
             br_close / emit_exp_fraction                              = array_object_br_close,   //
             idx_close / emit_exp_fraction                             = array_object_idx_close,  //
             whitespace / emit_exp_fraction                            = array_object,            //
-            eoi                                                       = hsm::internal,           //
+            eoi / emit_number_part                                    = hsm::internal,           //
             hsm::any / detail::error_action<invalid_number, self_t>() = error),
-        string_start_cont(                                       //
-            escape / mem_add_ch        = string_start_cont_esc,  //
-            quot / emit_str_first_last = array_object,           //
-            eoi[is_empty]              = hsm::internal,          //
-            eoi / emit_str_first       = string_n,               //
-            hsm::any / mem_add_ch      = string_start_cont),          //
-        string_start_cont_esc(                                   //
-            hsm::any / mem_add_ch = string_start_cont,           //
-            eoi[is_empty]         = hsm::internal,               //
-            eoi / emit_str_first  = string_n_esc),
-        string_n(quot / emit_str_n_last = array_object,          //
-                 escape / mem_n_str     = string_n_cont_esc,     //
-                 hsm::any / mem_n_str   = string_n_cont),          //
-        string_n_esc(hsm::any / mem_n_str = string_n_cont_esc),  //
-        string_n_cont(                                           //
-            hsm::any / mem_add_ch  = string_n_cont,              //
-            escape / mem_add_ch    = string_n_cont_esc,          //
-            quot / emit_str_n_last = array_object,               //
-            eoi[is_empty]          = hsm::internal,              //
-            eoi / emit_str_n       = string_n),
-        string_n_cont_esc(                          //
-            hsm::any / mem_add_ch = string_n_cont,  //
-            eoi[is_empty]         = hsm::internal,  //
-            eoi / emit_str_n      = string_n_esc),
+        string_start_cont(                                                   //
+            escape / mem_add_esc                   = string_start_cont_esc,  //
+            quot[invalid_text] / report_text_error = error,                  //
+            quot / emit_str_first_last             = array_object,           //
+            eoi[is_empty]                          = hsm::internal,          //
+            eoi[invalid_part] / report_text_error  = error,                  //
+            eoi / emit_str_first                   = string_n,               //
+            hsm::any / mem_add_ch                  = string_start_cont),     //
+        string_start_cont_esc(                                          //
+            hsm::any / mem_add_ch                 = string_start_cont,  //
+            eoi[is_empty]                         = hsm::internal,      //
+            eoi[invalid_part] / report_text_error = error,              //
+            eoi / emit_str_first                  = string_n_esc),      //
+        string_n(quot[invalid_text] / report_text_error = error,              //
+                 quot / emit_str_n_last                 = array_object,       //
+                 escape / mem_n_esc                     = string_n_cont_esc,  //
+                 hsm::any / mem_n_str                   = string_n_cont),     //
+        string_n_esc(hsm::any / mem_n_str = string_n_cont),  //
+        string_n_cont(                                                   //
+            hsm::any / mem_add_ch                  = string_n_cont,      //
+            escape / mem_add_esc                   = string_n_cont_esc,  //
+            quot[invalid_text] / report_text_error = error,              //
+            quot / emit_str_n_last                 = array_object,       //
+            eoi[is_empty]                          = hsm::internal,      //
+            eoi[invalid_part] / report_text_error  = error,              //
+            eoi / emit_str_n                       = string_n),          //
+        string_n_cont_esc(                                          //
+            hsm::any / mem_add_ch                 = string_n_cont,  //
+            eoi[is_empty]                         = hsm::internal,  //
+            eoi[invalid_part] / report_text_error = error,          //
+            eoi / emit_str_n                      = string_n_esc),  //
         member(                                                                         //
             hsm::initial = expect_quot,                                                 //
             expect_quot(                                                                //
@@ -310,30 +905,37 @@ auto basic_json_parser<Handler, Traits, IT>::setup_sm() -> void
                 quot                                                  = name_start_cont,  //
                 br_close[object_on_stack] / pop_object                = array_object,     //
                 hsm::any / detail::error_action<member_exp, self_t>() = error),
-            name_start_cont(                                        //
-                hsm::any / mem_add_ch       = name_start_cont,      //
-                escape / mem_add_ch         = name_start_cont_esc,  //
-                quot / emit_name_first_last = expect_colon,         //
-                eoi[is_empty]               = hsm::internal,        //
-                eoi / emit_name_first       = name_n),                    //
-            name_start_cont_esc(                                    //
-                hsm::any / mem_add_ch = name_start_cont,            //
-                eoi[is_empty]         = hsm::internal,              //
-                eoi / emit_name_first = name_n_esc),
-            name_n(quot / emit_name_n_last = expect_colon,       //
-                   escape / mem_n_str      = name_n_cont_esc,    //
-                   hsm::any / mem_n_str    = name_n_cont),          //
-            name_n_esc(hsm::any / mem_n_str = name_n_cont_esc),  //
-            name_n_cont(                                         //
-                hsm::any / mem_add_ch   = name_n_cont,           //
-                escape / mem_add_ch     = name_n_cont_esc,       //
-                quot / emit_name_n_last = expect_colon,          //
-                eoi[is_empty]           = hsm::internal,         //
-                eoi / emit_name_n       = name_n),
-            name_n_cont_esc(                            //
-                hsm::any / mem_add_ch = name_n_cont,    //
-                eoi[is_empty]         = hsm::internal,  //
-                eoi / emit_name_n     = name_n_esc)),
+            name_start_cont(                                                   //
+                escape / mem_add_esc                   = name_start_cont_esc,  //
+                quot[invalid_text] / report_text_error = error,                //
+                quot / emit_name_first_last            = expect_colon,         //
+                eoi[is_empty]                          = hsm::internal,        //
+                eoi[invalid_part] / report_text_error  = error,                //
+                eoi / emit_name_first                  = name_n,               //
+                hsm::any / mem_add_ch                  = name_start_cont),     //
+            name_start_cont_esc(                                          //
+                hsm::any / mem_add_ch                 = name_start_cont,  //
+                eoi[is_empty]                         = hsm::internal,    //
+                eoi[invalid_part] / report_text_error = error,            //
+                eoi / emit_name_first                 = name_n_esc),      //
+            name_n(quot[invalid_text] / report_text_error = error,            //
+                   quot / emit_name_n_last                = expect_colon,     //
+                   escape / mem_n_esc                     = name_n_cont_esc,  //
+                   hsm::any / mem_n_str                   = name_n_cont),     //
+            name_n_esc(hsm::any / mem_n_str = name_n_cont),  //
+            name_n_cont(                                                   //
+                hsm::any / mem_add_ch                  = name_n_cont,      //
+                escape / mem_add_esc                   = name_n_cont_esc,  //
+                quot[invalid_text] / report_text_error = error,            //
+                quot / emit_name_n_last                = expect_colon,     //
+                eoi[is_empty]                          = hsm::internal,    //
+                eoi[invalid_part] / report_text_error  = error,            //
+                eoi / emit_name_n                      = name_n),          //
+            name_n_cont_esc(                                            //
+                hsm::any / mem_add_ch                 = name_n_cont,    //
+                eoi[is_empty]                         = hsm::internal,  //
+                eoi[invalid_part] / report_text_error = error,          //
+                eoi / emit_name_n                     = name_n_esc)),   //
         expect_colon(                                                              //
             whitespace                                           = expect_colon,   //
             colon                                                = json_state,     //
@@ -365,10 +967,11 @@ auto basic_json_parser<Handler, Traits, IT>::setup_sm() -> void
             hsm::any / detail::error_action<comma_expected, self_t>() = error  //
             ));
     sm.start(*this);
-    process_events = [sm = std::move(sm)](sv_t const& bytes, int ctrl, self_t& self) mutable
+    process_events = [sm = std::move(sm)](sv_t const& bytes, int ctrl, self_t& self) mutable -> parse_result
     {
         if (ctrl < 0) sm.start(self);
         self.current_input_buffer = bytes;
+        if (self.number_started) self.number_begin = bytes.data();
 #ifdef ASYNC_JSON_PARSER_DEBUG
         auto to_state_name = [](int d) -> char const*
         {
@@ -405,60 +1008,521 @@ auto basic_json_parser<Handler, Traits, IT>::setup_sm() -> void
             return fpp[d];
         };
 #endif
-        auto switch_char = [&sm](char c, self_t& s) mutable
+        auto const string_start_cont_id = sm.get_state_id(string_start_cont);
+        auto const string_n_cont_id     = sm.get_state_id(string_n_cont);
+        auto const name_start_cont_id   = sm.get_state_id(name_start_cont);
+        auto const name_n_cont_id       = sm.get_state_id(name_n_cont);
+        auto const json_state_id        = sm.get_state_id(json_state);
+        auto const json_in_array_id     = sm.get_state_id(json_state_in_array);
+        auto const array_object_id      = sm.get_state_id(array_object);
+        auto const expect_quot_id       = sm.get_state_id(expect_quot);
+        auto const expect_colon_id      = sm.get_state_id(expect_colon);
+        auto const int_number_id        = sm.get_state_id(int_number_state);
+        auto const fraction_number_id   = sm.get_state_id(fraction_number);
+        auto const exp_state_id         = sm.get_state_id(exp_state);
+        auto const error_id             = sm.get_state_id(error);
+        if (ctrl > 0)
         {
-            switch (c)
+            // end of the input: a number at the top level, also a skipped number or keyword, has no delimiter, a line
+            // break completes it, any other open value is incomplete
+            auto const state       = sm.current_state_id();
+            bool const number      = state == int_number_id || state == fraction_number_id || state == exp_state_id;
+            bool const skip_scalar = self.skip_state.active && self.skip_state.depth == 0 && !self.skip_state.in_string;
+            if (self.state_stack.empty() && (number || skip_scalar))
             {
-                case 'n': return sm.process_event(n, s);
-                case 't': return sm.process_event(t, s);
-                case 'f': return sm.process_event(f, s);
-                case '{': return sm.process_event(br_open, s);
-                case '}': return sm.process_event(br_close, s);
-                case '[': return sm.process_event(idx_open, s);
-                case ']': return sm.process_event(idx_close, s);
-                case '"': return sm.process_event(quot, s);
-                case ':': return sm.process_event(colon, s);
-                case ',': return sm.process_event(comma, s);
-                case '+': return sm.process_event(plus, s);
-                case '-': return sm.process_event(minus, s);
-                case '0': /* fall-through */
-                case '1':
-                case '2':
-                case '3':
-                case '4':
-                case '5':
-                case '6':
-                case '7':
-                case '8':
-                case '9': return sm.process_event(digit, s);
-                case '\\': return sm.process_event(escape, s);
-                case 'E':
-                case 'e': return sm.process_event(exponent, s);
-                case '.': return sm.process_event(dot, s);
-                case ' ':
-                case '\b':
-                case '\t':
-                case '\r':
-                case '\n': return sm.process_event(whitespace, s);
-                default: return sm.process_event(ch, s);
+                auto const ret = self.process_events(sv_t("\n", 1), 0, self);
+                return {ret.status, 0};
             }
-        };
-        for (auto elem : bytes)
+            if (state == error_id) return {parse_status::error, 0};
+            if constexpr (multi_document)
+            {
+                // the rest of a line with an error was dropped and reported already
+                self.skip_line = false;
+                if (!self.in_document) return {parse_status::done, 0};
+                self.cbs(event_value(saj_event::parse_error, incomplete_input));
+                self.abandon_document(sm);
+                self.skip_line = false;
+            }
+            else
+            {
+                if (state == sm.get_state_id(done)) return {parse_status::done, 0};
+                self.cbs(event_value(saj_event::parse_error, incomplete_input));
+            }
+            return {parse_status::error, 0};
+        }
+        auto const consumed             = [&bytes, &self] { return bytes.size() - self.current_input_buffer.size(); };
+        bool       suspended            = false;
+        while (!self.current_input_buffer.empty())
         {
-            self.cur = elem;
+            if constexpr (multi_document)
+            {
+                if (self.skip_line && !self.skip_to_next_line()) break;
+            }
+            if constexpr (detail::has_skip_request<Handler>::value)
+            {
+                if (self.skip_state.active)
+                {
+                    if (!self.skip_value()) break;
+                    sm.process_event(skipped, self);
+                    if constexpr (multi_document) self.end_document(sm);
+                    if (self.suspend_requested())
+                    {
+                        suspended = true;
+                        break;
+                    }
+                    continue;
+                }
+            }
+            auto const state = sm.current_state_id();
+            if (state == string_start_cont_id || state == string_n_cont_id || state == name_start_cont_id || state == name_n_cont_id)
+            {
+                self.consume_string_run();
+                if (self.current_input_buffer.empty()) break;
+            }
+            else if (state == json_state_id || state == json_in_array_id || state == array_object_id || state == expect_quot_id ||
+                     state == expect_colon_id)
+            {
+                self.consume_whitespace();
+                if (self.current_input_buffer.empty()) break;
+                if constexpr (multi_document) self.begin_document();
+                if (state == json_state_id || state == json_in_array_id)
+                {
+                    if (self.begin_skip()) continue;
+                    if (self.consume_keyword(sm))
+                    {
+                        if constexpr (multi_document) self.end_document(sm);
+                        if (self.suspend_requested())
+                        {
+                            suspended = true;
+                            break;
+                        }
+                        continue;
+                    }
+                }
+            }
+            else if (state == int_number_id || state == fraction_number_id || state == exp_state_id)
+            {
+                if (state == exp_state_id)
+                    self.consume_exponent_digits();
+                else
+                    self.consume_digits(state == fraction_number_id);
+                if (self.current_input_buffer.empty()) break;
+            }
+            self.cur = self.current_input_buffer.front();
 #ifdef ASYNC_JSON_PARSER_DEBUG
             std::cout << &self << "Parse: '" << self.cur << "' " << to_state_name(static_cast<int>(sm.current_state_id())) << " ";
-            for (auto const& entry : self.state_stack) std::cout << int(entry) << " ";
+            for (size_t level = 0; level != self.state_stack.size(); ++level) std::cout << int(self.state_stack[level]) << " ";
             std::cout << "\n";
 #endif
-            switch_char(self.cur, self);
-            if (sm.current_state_id() == sm.get_state_id(error)) return false;
-            ++self.byte_count;
-            self.current_input_buffer = sv_t(self.current_input_buffer.begin() + 1, self.current_input_buffer.size() - 1);
+            if constexpr (multi_document) self.begin_document();
+            auto const cls = char_class_table[static_cast<unsigned char>(self.cur)];
+            sm.process_event(static_cast<typename decltype(sm)::event_id>(cast(cls)), self);
+            if (sm.current_state_id() == error_id)
+            {
+                if constexpr (!multi_document) return {parse_status::error, consumed()};
+                // only the current document is lost, parsing continues on the next line
+                self.abandon_document(sm);
+                if (self.suspend_requested())
+                {
+                    suspended = true;
+                    break;
+                }
+                continue;
+            }
+            self.advance(1);
+            if constexpr (multi_document) self.end_document(sm);
+            if (self.suspend_requested())
+            {
+                suspended = true;
+                break;
+            }
         }
+        // a suspension ends the buffer like the end of the input, partial strings and numbers are reported so far
         sm.process_event(eoi, self);
-        return sm.current_state_id() != sm.get_state_id(error);
+        if constexpr (multi_document)
+        {
+            if (sm.current_state_id() == error_id) self.abandon_document(sm);
+            if (suspended) return {parse_status::suspended, consumed()};
+            return {self.in_document || self.skip_line ? parse_status::need_more : parse_status::done, consumed()};
+        }
+        else
+        {
+            if (sm.current_state_id() == error_id) return {parse_status::error, consumed()};
+            if (suspended) return {parse_status::suspended, consumed()};
+            return {sm.current_state_id() == sm.get_state_id(done) ? parse_status::done : parse_status::need_more, consumed()};
+        }
+    };
+}
+
+template <typename Handler, typename Traits, typename IT>
+auto basic_json_parser<Handler, Traits, IT>::advance(size_t count) -> void
+{
+    byte_count += count;
+    current_input_buffer = sv_t(current_input_buffer.data() + count, current_input_buffer.size() - count);
+}
+
+// Appends all plain characters up to the next '"' or '\\' of the current buffer to parsed_view in one step.
+// The terminating character is left for the state machine.
+template <typename Handler, typename Traits, typename IT>
+auto basic_json_parser<Handler, Traits, IT>::consume_string_run() -> void
+{
+    auto const first = current_input_buffer.data();
+    auto const count = static_cast<size_t>(detail::find_quote_or_escape(first, first + current_input_buffer.size()) - first);
+    if (count == 0) return;
+    parsed_view = sv_t(parsed_view.empty() ? first : parsed_view.data(), parsed_view.size() + count);
+    advance(count);
+}
+
+// Skips a run of whitespace in states where whitespace would only cause an internal transition.
+template <typename Handler, typename Traits, typename IT>
+auto basic_json_parser<Handler, Traits, IT>::consume_whitespace() -> void
+{
+    auto const first = current_input_buffer.data();
+    advance(static_cast<size_t>(detail::skip_whitespace(first, first + current_input_buffer.size()) - first));
+}
+
+// Accumulates all digits of the current buffer in one step instead of one add_digit_* transition per digit.
+template <typename Handler, typename Traits, typename IT>
+auto basic_json_parser<Handler, Traits, IT>::consume_digits(bool fraction) -> void
+{
+    auto const first = current_input_buffer.data();
+    auto const last  = first + current_input_buffer.size();
+    if constexpr (raw_numbers)
+    {
+        advance(static_cast<size_t>(detail::skip_digits(first, last) - first));
+        return;
+    }
+    auto it = first;
+    for (; last - it >= 8; it += 8)
+    {
+        auto const v = detail::load_u64_le(it);
+        if (!detail::is_eight_digits(v)) break;
+        auto const block = detail::parse_eight_digits(v);
+        if (!fraction) int_number = int_number * 100000000ull + block;
+        if (decimal.has_room_for_eight_digits())
+            decimal.add_eight_digits(block, fraction);
+        else
+            for (int i = 0; i != 8; ++i) decimal.add_digit(static_cast<unsigned>(it[i] - '0'), fraction);
+    }
+    for (; it != last && detail::is_digit(*it); ++it)
+    {
+        if (!fraction) int_number = int_number * 10 + static_cast<unsigned>(*it - '0');
+        decimal.add_digit(static_cast<unsigned>(*it - '0'), fraction);
+    }
+    advance(static_cast<size_t>(it - first));
+}
+
+template <typename Handler, typename Traits, typename IT>
+auto basic_json_parser<Handler, Traits, IT>::consume_exponent_digits() -> void
+{
+    auto const first = current_input_buffer.data();
+    auto const last  = first + current_input_buffer.size();
+    if constexpr (raw_numbers)
+    {
+        advance(static_cast<size_t>(detail::skip_digits(first, last) - first));
+        return;
+    }
+    auto it = first;
+    for (; it != last && detail::is_digit(*it); ++it)
+        exp_number = std::min(exp_number * 10 + static_cast<unsigned>(*it - '0'), detail::exponent_limit);
+    advance(static_cast<size_t>(it - first));
+}
+
+// Emits true, false or null at once when the whole keyword is within the current buffer.
+// Keywords split across buffers are matched character by character in the keyword state.
+template <typename Handler, typename Traits, typename IT>
+template <typename SM>
+auto basic_json_parser<Handler, Traits, IT>::consume_keyword(SM& sm) -> bool
+{
+    auto const first = current_input_buffer.data();
+    auto const size  = current_input_buffer.size();
+    switch (*first)
+    {
+        case 't':
+            if (size < 4 || !detail::equals_four(first, "true")) return false;
+            sm.process_event(detail::true_kw, *this);
+            advance(4);
+            return true;
+        case 'f':
+            if (size < 5 || !detail::equals_four(first + 1, "alse")) return false;
+            sm.process_event(detail::false_kw, *this);
+            advance(5);
+            return true;
+        case 'n':
+            if (size < 4 || !detail::equals_four(first, "null")) return false;
+            sm.process_event(detail::null_kw, *this);
+            advance(4);
+            return true;
+        default: return false;
+    }
+}
+
+// Reports the characters of the current number seen so far in this buffer, the first part as number_value_start.
+// When last is set the number is complete and number_value_end follows.
+template <typename Handler, typename Traits, typename IT>
+auto basic_json_parser<Handler, Traits, IT>::emit_number_span(bool last) -> void
+{
+    auto const end = current_input_buffer.data();
+    if (number_begin != end)
+    {
+        cbs(event_value(number_started ? saj_event::number_value_cont : saj_event::number_value_start,
+                        sv_t(number_begin, static_cast<size_t>(end - number_begin))));
+        number_started = true;
+    }
+    number_begin = end;
+    if (last)
+    {
+        cbs(event_value(saj_event::number_value_end));
+        number_started = false;
+    }
+}
+
+template <typename Handler, typename Traits, typename IT>
+auto basic_json_parser<Handler, Traits, IT>::emit_name_part(saj_event ev) -> void
+{
+    if constexpr (name_hashes) name_hash = hash_name_part(name_hash, std::string_view(parsed_view.data(), parsed_view.size()));
+    cbs(event_value(ev, parsed_view));
+    parsed_view = sv_t(nullptr, 0);
+}
+
+template <typename Handler, typename Traits, typename IT>
+auto basic_json_parser<Handler, Traits, IT>::emit_name_end() -> void
+{
+    if constexpr (name_hashes)
+    {
+        cbs(event_value::name_end(name_hash));
+        name_hash = name_hash_seed;
+    }
+    else
+        cbs(event_value(saj_event::object_name_end));
+}
+
+// Moves the part of a string or name at the end of the current buffer into the scratch buffer.
+template <typename Handler, typename Traits, typename IT>
+auto basic_json_parser<Handler, Traits, IT>::buffer_text_part() -> void
+{
+    if (!text_buffered) scratch.clear();
+    text_buffered = true;
+    scratch.append(parsed_view.data(), parsed_view.size());
+    parsed_view = sv_t(nullptr, 0);
+}
+
+// Points parsed_view to the complete decoded string or name. Unescaped strings within
+// one buffer are left in place, all others end up in the scratch buffer.
+template <typename Handler, typename Traits, typename IT>
+auto basic_json_parser<Handler, Traits, IT>::decode_text() -> bool
+{
+    if constexpr (decode_escapes)
+    {
+        auto const escaped  = std::exchange(text_escaped, false);
+        auto const buffered = std::exchange(text_buffered, false);
+        if (!escaped && !buffered) return true;
+        char const* first = parsed_view.data();
+        if (buffered)
+        {
+            scratch.append(parsed_view.data(), parsed_view.size());
+            first = scratch.data();
+        }
+        else
+            scratch.resize(parsed_view.size());
+        if (escaped)
+        {
+            // decoding never grows the text, so buffered text is decoded in place
+            auto const ret = json_to_utf8(std::string_view(first, scratch.size()), scratch.data());
+            if (ret.status != decode_status::ok) return false;
+            scratch.resize(ret.written);
+        }
+        parsed_view = sv_t(scratch.data(), scratch.size());
+    }
+    return true;
+}
+
+// With validate_utf8 checks the part of a string or name in parsed_view, multi byte sequences may continue in the next part.
+template <typename Handler, typename Traits, typename IT>
+auto basic_json_parser<Handler, Traits, IT>::check_text_part() -> bool
+{
+    if constexpr (utf8_validation)
+    {
+        if (!detail::validate_utf8(parsed_view.data(), parsed_view.data() + parsed_view.size(), text_utf8))
+        {
+            text_error = invalid_utf8;
+            return false;
+        }
+    }
+    return true;
+}
+
+// Called on the closing quote with the last part of a string or name, on failure text_error holds the cause.
+template <typename Handler, typename Traits, typename IT>
+auto basic_json_parser<Handler, Traits, IT>::finish_text() -> bool
+{
+    if (!check_text_part()) return false;
+    if constexpr (utf8_validation)
+    {
+        if (!text_utf8.complete())
+        {
+            text_error = invalid_utf8;
+            return false;
+        }
+    }
+    if (!decode_text())
+    {
+        text_error = invalid_escape;
+        return false;
+    }
+    return true;
+}
+
+template <typename Handler, typename Traits, typename IT>
+auto basic_json_parser<Handler, Traits, IT>::clear_document_state() -> void
+{
+    num_sign       = 1;
+    exp_sign       = 1;
+    exp_number     = 0;
+    int_number     = 0;
+    number_begin   = nullptr;
+    number_started = false;
+    kw_state       = keyword_receive{};
+    parsed_view    = sv_t(nullptr, 0);
+    decimal.clear();
+    state_stack.clear();
+    skip_state = value_skip{};
+    name_hash  = name_hash_seed;
+    text_escaped  = false;
+    text_buffered = false;
+    text_utf8     = detail::utf8_state{};
+}
+
+template <typename Handler, typename Traits, typename IT>
+auto basic_json_parser<Handler, Traits, IT>::begin_document() -> void
+{
+    if (in_document) return;
+    cbs(event_value(saj_event::document_start));
+    in_document = true;
+}
+
+// Closes the current document once its top level value is complete and restarts the state machine for the next one.
+template <typename Handler, typename Traits, typename IT>
+template <typename SM>
+auto basic_json_parser<Handler, Traits, IT>::end_document(SM& sm) -> void
+{
+    if (sm.current_state_id() != sm.get_state_id(detail::done)) return;
+    cbs(event_value(saj_event::document_end));
+    in_document = false;
+    sm.start(*this);
+}
+
+// Closes the current document after a parse error, the remainder of its line is skipped.
+template <typename Handler, typename Traits, typename IT>
+template <typename SM>
+auto basic_json_parser<Handler, Traits, IT>::abandon_document(SM& sm) -> void
+{
+    cbs(event_value(saj_event::document_end));
+    in_document = false;
+    skip_line   = true;
+    clear_document_state();
+    sm.start(*this);
+}
+
+// Drops input up to and including the next newline, returns false if the buffer ends before that.
+template <typename Handler, typename Traits, typename IT>
+auto basic_json_parser<Handler, Traits, IT>::skip_to_next_line() -> bool
+{
+    auto const first = current_input_buffer.data();
+    auto const size  = current_input_buffer.size();
+    auto const nl    = static_cast<char const*>(std::memchr(first, '\n', size));
+    if (nl == nullptr)
+    {
+        advance(size);
+        return false;
+    }
+    advance(static_cast<size_t>(nl - first) + 1);
+    skip_line = false;
+    return !current_input_buffer.empty();
+}
+
+// Asks the handler whether the value at the front of the buffer should be skipped and starts skipping it.
+// Characters that cannot begin a value are left to the state machine to report the error.
+template <typename Handler, typename Traits, typename IT>
+auto basic_json_parser<Handler, Traits, IT>::begin_skip() -> bool
+{
+    if constexpr (detail::has_skip_request<Handler>::value)
+    {
+        auto const c = current_input_buffer.front();
+        if (!(c == '{' || c == '[' || c == '"' || c == '-' || c == 't' || c == 'f' || c == 'n' || detail::is_digit(c))) return false;
+        if (!cbs.skip_requested()) return false;
+        skip_state.active = true;
+        if (c == '{' || c == '[')
+        {
+            skip_state.depth = 1;
+            advance(1);
+        }
+        else if (c == '"')
+        {
+            skip_state.in_string = true;
+            advance(1);
+        }
+        return true;
+    }
+    else
+        return false;
+}
+
+// Drops the input of a skipped value, containers end at the matching bracket, strings at the closing quote and
+// numbers or keywords before the next delimiter. Returns false if the buffer ends before the value.
+template <typename Handler, typename Traits, typename IT>
+auto basic_json_parser<Handler, Traits, IT>::skip_value() -> bool
+{
+    auto const first  = current_input_buffer.data();
+    auto const last   = first + current_input_buffer.size();
+    auto const finish = [this, first](char const* end)
+    {
+        advance(static_cast<size_t>(end - first));
+        skip_state = value_skip{};
+        return true;
     };
+    auto it = first;
+    while (it != last)
+    {
+        if (skip_state.escaped)
+        {
+            skip_state.escaped = false;
+            ++it;
+        }
+        else if (skip_state.in_string)
+        {
+            it = detail::find_quote_or_escape(it, last);
+            if (it == last) break;
+            if (*it++ == '\\')
+                skip_state.escaped = true;
+            else
+            {
+                skip_state.in_string = false;
+                if (skip_state.depth == 0) return finish(it);
+            }
+        }
+        else if (skip_state.depth == 0)
+        {
+            if (detail::is_whitespace(*it) || *it == ',' || *it == '}' || *it == ']') return finish(it);
+            ++it;
+        }
+        else
+        {
+            it = detail::find_quote_or_bracket(it, last);
+            if (it == last) break;
+            switch (*it++)
+            {
+                case '"': skip_state.in_string = true; break;
+                case '{':
+                case '[': ++skip_state.depth; break;
+                default:
+                    if (--skip_state.depth == 0) return finish(it);
+                    break;
+            }
+        }
+    }
+    advance(static_cast<size_t>(last - first));
+    return false;
 }
 
 template <typename Handler, typename Traits, typename IT>
@@ -476,12 +1540,11 @@ basic_json_parser<Handler, Traits, IT>::basic_json_parser()
 template <typename Handler, typename Traits, typename IT>
 auto basic_json_parser<Handler, Traits, IT>::reset() -> void
 {
-    exp_sign    = 1;
-    frac_digits = 0;
-    exp_number  = 0;
-    int_number  = 0;
-    fraction    = 0;
+    clear_document_state();
     byte_count  = 0;
+    in_document = false;
+    skip_line   = false;
+    if constexpr (detail::has_clear<Handler>::value) cbs.clear();
     process_events(sv_t{}, -1, *this);
 }
 }  // namespace async_json
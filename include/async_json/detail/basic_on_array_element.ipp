@@ -28,10 +28,13 @@ inline void basic_on_array_element<Traits, IT>::setup_sm()
         a_start = handle_values,
         handle_values(o_start                       = count_objects,    //
                       str_start                     = consume_strings,  //
+                      num_start                     = consume_strings,  //
                       hsm::any[is_value] / ret_true = handle_values),   //
         consume_strings(                                                //
             str_cont           = hsm::internal,
-            str_end / ret_true = handle_values),        //
+            num_cont           = hsm::internal,
+            str_end / ret_true = handle_values,         //
+            num_end / ret_true = handle_values),        //
         a_end = hsm::root,                              //
         count_objects(                                  //
             o_end[is_zero] / ret_true = handle_values,  //
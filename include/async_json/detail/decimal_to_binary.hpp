@@ -0,0 +1,334 @@
+/* ==========================================================================
+ Copyright (c) 2024 Andreas Pokorny
+ Distributed under the Boost Software License, Version 1.0. (See accompanying
+ file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+========================================================================== */
+
+#ifndef ASYNC_JSON_DETAIL_DECIMAL_TO_BINARY_HPP_INCLUDED
+#define ASYNC_JSON_DETAIL_DECIMAL_TO_BINARY_HPP_INCLUDED
+
+#include <cfloat>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <async_json/detail/power_of_five_table.hpp>
+
+#if defined(_MSC_VER) && !defined(__clang__) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+// Decimal to binary floating point conversion based on the Eisel-Lemire algorithm:
+// D. Lemire, "Number Parsing at a Gigabyte per Second", Software: Practice and Experience 51 (8), 2021
+// N. Mushtak, D. Lemire, "Fast Number Parsing Without Fallback", Software: Practice and Experience 53 (6), 2023
+namespace async_json
+{
+namespace detail
+{
+struct value128
+{
+    std::uint64_t low;
+    std::uint64_t high;
+};
+
+inline value128 full_multiplication(std::uint64_t a, std::uint64_t b) noexcept
+{
+#if defined(__SIZEOF_INT128__)
+    auto const r = static_cast<unsigned __int128>(a) * b;
+    return {static_cast<std::uint64_t>(r), static_cast<std::uint64_t>(r >> 64)};
+#elif defined(_MSC_VER) && !defined(__clang__) && defined(_M_X64)
+    value128 r;
+    r.low = _umul128(a, b, &r.high);
+    return r;
+#else
+    auto const a_lo = a & 0xFFFFFFFFu, a_hi = a >> 32, b_lo = b & 0xFFFFFFFFu, b_hi = b >> 32;
+    auto const lo_lo = a_lo * b_lo, hi_lo = a_hi * b_lo, lo_hi = a_lo * b_hi, hi_hi = a_hi * b_hi;
+    auto const cross = (lo_lo >> 32) + (hi_lo & 0xFFFFFFFFu) + lo_hi;
+    return {(cross << 32) | (lo_lo & 0xFFFFFFFFu), (hi_lo >> 32) + (cross >> 32) + hi_hi};
+#endif
+}
+
+inline int leading_zeroes(std::uint64_t v) noexcept
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long index;
+    _BitScanReverse64(&index, v);
+    return 63 - static_cast<int>(index);
+#else
+    return __builtin_clzll(v);
+#endif
+}
+
+template <typename T>
+struct binary_format;
+
+template <>
+struct binary_format<double>
+{
+    using bits_t                                    = std::uint64_t;
+    static constexpr int     mantissa_explicit_bits = 52;
+    static constexpr int     minimum_exponent       = -1023;
+    static constexpr int     infinite_power         = 0x7FF;
+    static constexpr int     sign_index             = 63;
+    static constexpr int     min_exponent_fast_path = -22;
+    static constexpr int     max_exponent_fast_path = 22;
+    static constexpr int     min_exponent_round_to_even = -4;
+    static constexpr int     max_exponent_round_to_even = 23;
+    static constexpr int     smallest_power_of_ten      = -342;
+    static constexpr int     largest_power_of_ten       = 308;
+    static constexpr std::uint64_t max_mantissa_fast_path = std::uint64_t(2) << mantissa_explicit_bits;
+    static double            exact_power_of_ten(int e) noexcept
+    {
+        constexpr double powers[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                     1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+        return powers[e];
+    }
+    static double parse_string(char const* str) noexcept { return std::strtod(str, nullptr); }
+};
+
+template <>
+struct binary_format<float>
+{
+    using bits_t                                    = std::uint32_t;
+    static constexpr int     mantissa_explicit_bits = 23;
+    static constexpr int     minimum_exponent       = -127;
+    static constexpr int     infinite_power         = 0xFF;
+    static constexpr int     sign_index             = 31;
+    static constexpr int     min_exponent_fast_path = -10;
+    static constexpr int     max_exponent_fast_path = 10;
+    static constexpr int     min_exponent_round_to_even = -17;
+    static constexpr int     max_exponent_round_to_even = 10;
+    static constexpr int     smallest_power_of_ten      = -65;
+    static constexpr int     largest_power_of_ten       = 38;
+    static constexpr std::uint64_t max_mantissa_fast_path = std::uint64_t(2) << mantissa_explicit_bits;
+    static float             exact_power_of_ten(int e) noexcept
+    {
+        constexpr float powers[] = {1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f};
+        return powers[e];
+    }
+    static float parse_string(char const* str) noexcept { return std::strtof(str, nullptr); }
+};
+
+struct adjusted_mantissa
+{
+    std::uint64_t mantissa{0};
+    int           power2{0};
+};
+
+// floor(log2(10^q)) + 63
+constexpr int binary_power(int q) noexcept { return (((152170 + 65536) * q) >> 16) + 63; }
+
+// Computes w * 5^q with enough precision for bit_precision bits of the result.
+template <int bit_precision>
+value128 compute_product_approximation(std::int64_t q, std::uint64_t w) noexcept
+{
+    auto const index         = 2 * static_cast<int>(q - smallest_power_of_five);
+    auto       first_product = full_multiplication(w, power_of_five_128[index]);
+    constexpr std::uint64_t precision_mask = std::uint64_t(0xFFFFFFFFFFFFFFFF) >> bit_precision;
+    if ((first_product.high & precision_mask) == precision_mask)
+    {
+        auto const second_product = full_multiplication(w, power_of_five_128[index + 1]);
+        first_product.low += second_product.high;
+        if (second_product.high > first_product.low) ++first_product.high;
+    }
+    return first_product;
+}
+
+/// Computes the binary mantissa and exponent of w * 10^q rounded to nearest, ties to even.
+template <typename T>
+adjusted_mantissa compute_float(std::int64_t q, std::uint64_t w) noexcept
+{
+    using binary = binary_format<T>;
+    adjusted_mantissa answer;
+    if (w == 0 || q < binary::smallest_power_of_ten) return answer;
+    if (q > binary::largest_power_of_ten)
+    {
+        answer.power2 = binary::infinite_power;
+        return answer;
+    }
+    auto const lz = leading_zeroes(w);
+    w <<= lz;
+    auto const product  = compute_product_approximation<binary::mantissa_explicit_bits + 3>(q, w);
+    auto const upperbit = static_cast<int>(product.high >> 63);
+    auto const shift    = upperbit + 64 - binary::mantissa_explicit_bits - 3;
+
+    answer.mantissa = product.high >> shift;
+    answer.power2   = binary_power(static_cast<int>(q)) + upperbit - lz - binary::minimum_exponent;
+    if (answer.power2 <= 0)
+    {
+        // subnormal or zero
+        if (-answer.power2 + 1 >= 64)
+        {
+            answer = adjusted_mantissa{};
+            return answer;
+        }
+        answer.mantissa >>= -answer.power2 + 1;
+        answer.mantissa += (answer.mantissa & 1);
+        answer.mantissa >>= 1;
+        // rounding up may turn the largest subnormal into the smallest normal number
+        answer.power2 = (answer.mantissa < (std::uint64_t(1) << binary::mantissa_explicit_bits)) ? 0 : 1;
+        return answer;
+    }
+
+    // only exact halfway cases may need to round down to even, those only exist where 5^q fits into 64 bits
+    if (product.low <= 1 && q >= binary::min_exponent_round_to_even && q <= binary::max_exponent_round_to_even &&
+        (answer.mantissa & 3) == 1)
+    {
+        if ((answer.mantissa << shift) == product.high) answer.mantissa &= ~std::uint64_t(1);
+    }
+
+    answer.mantissa += (answer.mantissa & 1);
+    answer.mantissa >>= 1;
+    if (answer.mantissa >= (std::uint64_t(2) << binary::mantissa_explicit_bits))
+    {
+        answer.mantissa = std::uint64_t(1) << binary::mantissa_explicit_bits;
+        ++answer.power2;
+    }
+    answer.mantissa &= ~(std::uint64_t(1) << binary::mantissa_explicit_bits);
+    if (answer.power2 >= binary::infinite_power)
+    {
+        answer.power2   = binary::infinite_power;
+        answer.mantissa = 0;
+    }
+    return answer;
+}
+
+template <typename T>
+T to_binary(bool negative, adjusted_mantissa am) noexcept
+{
+    using binary = binary_format<T>;
+    using bits_t = typename binary::bits_t;
+    auto bits    = static_cast<bits_t>(am.mantissa | (static_cast<std::uint64_t>(am.power2) << binary::mantissa_explicit_bits) |
+                                    (static_cast<std::uint64_t>(negative) << binary::sign_index));
+    T    value;
+    std::memcpy(&value, &bits, sizeof value);
+    return value;
+}
+
+// exact float arithmetic is only guaranteed when intermediate results are not kept in extended precision
+#if defined(FLT_EVAL_METHOD) && (FLT_EVAL_METHOD == 0 || FLT_EVAL_METHOD == 1)
+constexpr bool clinger_fast_path_allowed = true;
+#else
+constexpr bool clinger_fast_path_allowed = false;
+#endif
+
+/// Converts (-1)^negative * w * 10^q to float or double with correct rounding.
+template <typename T>
+T decimal_to_binary(bool negative, std::uint64_t w, std::int64_t q) noexcept
+{
+    using binary = binary_format<T>;
+    if (clinger_fast_path_allowed && q >= binary::min_exponent_fast_path && q <= binary::max_exponent_fast_path &&
+        w <= binary::max_mantissa_fast_path)
+    {
+        // w and 10^|q| are exact, so a single IEEE operation rounds correctly
+        auto value = static_cast<T>(w);
+        if (q < 0)
+            value = value / binary::exact_power_of_ten(static_cast<int>(-q));
+        else
+            value = value * binary::exact_power_of_ten(static_cast<int>(q));
+        return negative ? -value : value;
+    }
+    return to_binary<T>(negative, compute_float<T>(q, w));
+}
+
+/// Converts (-1)^negative * digits * 10^q with the C library, used when the significand has more than 19 digits.
+template <typename T>
+T decimal_string_to_binary(bool negative, std::string_view digits, std::int64_t q)
+{
+    std::string str;
+    str.reserve(digits.size() + 24);
+    if (negative) str.push_back('-');
+    str.append(digits.begin(), digits.end());
+    str.push_back('e');
+    str.append(std::to_string(q));
+    if constexpr (std::is_same_v<T, float> || std::is_same_v<T, double>)
+        return binary_format<T>::parse_string(str.c_str());
+    else
+        return static_cast<T>(std::strtold(str.c_str(), nullptr));
+}
+
+/// Significant digits and decimal exponent of a number that is received one digit or digit block at a time.
+/// The first 19 significant digits are kept in a 64 bit integer. When a number has more, the complete
+/// digit string is kept as well so that ambiguous cases can still be rounded correctly.
+// decimal exponents are saturated here, far beyond the range of any floating point type
+constexpr unsigned long long exponent_limit = 100000000ull;
+
+struct decimal_number
+{
+    static constexpr int         max_fast_digits = 19;
+    static constexpr std::size_t max_digits      = 800;  // more than the 767 significant digits a halfway point between doubles can have
+
+    std::uint64_t significand{0};
+    std::int64_t  exponent{0};
+    int           digits{0};
+    bool          truncated{false};
+    bool          sticky{false};
+    std::string   long_digits;
+
+    void add_digit(unsigned digit, bool fraction)
+    {
+        if (digits < max_fast_digits)
+        {
+            significand = significand * 10 + digit;
+            digits += significand != 0;
+            exponent -= fraction;
+            return;
+        }
+        if (long_digits.empty()) long_digits = std::to_string(significand);
+        if (long_digits.size() < max_digits)
+            long_digits.push_back(static_cast<char>('0' + digit));
+        else
+            sticky |= digit != 0;
+        truncated |= digit != 0;
+        exponent += !fraction;
+    }
+
+    // adds a block of eight digits, requires a non zero significand with room for eight more digits
+    void add_eight_digits(std::uint32_t block, bool fraction) noexcept
+    {
+        significand = significand * 100000000u + block;
+        digits += 8;
+        exponent -= fraction ? 8 : 0;
+    }
+    constexpr bool has_room_for_eight_digits() const noexcept { return significand != 0 && digits + 8 <= max_fast_digits; }
+
+    void clear() noexcept
+    {
+        significand = 0;
+        exponent    = 0;
+        digits      = 0;
+        truncated   = false;
+        sticky      = false;
+        long_digits.clear();
+    }
+
+    /// Returns the value multiplied by 10^exp10 rounded to the nearest T.
+    template <typename T>
+    T convert(bool negative, std::int64_t exp10) const
+    {
+        auto const q = exponent + exp10;
+        if constexpr (std::is_same_v<T, float> || std::is_same_v<T, double>)
+        {
+            if (!truncated) return decimal_to_binary<T>(negative, significand, q);
+            // the dropped digits are non zero, so the value is strictly between significand and significand + 1
+            auto const lower = decimal_to_binary<T>(negative, significand, q);
+            if (lower == decimal_to_binary<T>(negative, significand + 1, q)) return lower;
+        }
+        else if (!truncated)
+        {
+            return decimal_string_to_binary<T>(negative, std::to_string(significand), q);
+        }
+        // long_digits holds all digits up to max_digits, significand the first 19 of them
+        auto const extra = static_cast<std::int64_t>(long_digits.size()) - max_fast_digits;
+        if (!sticky) return decimal_string_to_binary<T>(negative, long_digits, q - extra);
+        return decimal_string_to_binary<T>(negative, long_digits + '1', q - extra - 1);
+    }
+};
+
+}  // namespace detail
+}  // namespace async_json
+
+#endif
@@ -0,0 +1,78 @@
+/* ==========================================================================
+ Copyright (c) 2024 Andreas Pokorny
+ Distributed under the Boost Software License, Version 1.0. (See accompanying
+ file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+========================================================================== */
+
+#ifndef ASYNC_JSON_DETAIL_NESTING_STACK_HPP_INCLUDED
+#define ASYNC_JSON_DETAIL_NESTING_STACK_HPP_INCLUDED
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace async_json
+{
+namespace detail
+{
+// Open objects and arrays of the parser: 0 for an object, 1 for an array.
+struct dynamic_nesting_stack
+{
+    bool    full() const noexcept { return false; }
+    bool    empty() const noexcept { return levels.empty(); }
+    size_t  size() const noexcept { return levels.size(); }
+    uint8_t back() const noexcept { return levels.back(); }
+    uint8_t operator[](size_t level) const noexcept { return levels[level]; }
+    void    push_back(uint8_t kind) { levels.push_back(kind); }
+    void    pop_back() noexcept { levels.pop_back(); }
+    void    clear() noexcept { levels.clear(); }
+
+   private:
+    std::vector<uint8_t> levels;
+};
+
+// Same as dynamic_nesting_stack with one bit per level in a fixed size buffer.
+template <size_t MaxDepth>
+struct fixed_nesting_stack
+{
+    static_assert(MaxDepth > 0);
+
+    bool    full() const noexcept { return depth == MaxDepth; }
+    bool    empty() const noexcept { return depth == 0; }
+    size_t  size() const noexcept { return depth; }
+    uint8_t back() const noexcept { return (*this)[depth - 1]; }
+    uint8_t operator[](size_t level) const noexcept { return (bits[level / 64] >> (level % 64)) & 1; }
+    void    push_back(uint8_t kind) noexcept
+    {
+        auto& word = bits[depth / 64];
+        auto  bit  = std::uint64_t{1} << (depth % 64);
+        word       = kind ? (word | bit) : (word & ~bit);
+        ++depth;
+    }
+    void pop_back() noexcept { --depth; }
+    void clear() noexcept { depth = 0; }
+
+   private:
+    std::array<std::uint64_t, (MaxDepth + 63) / 64> bits{};
+    size_t                                          depth{0};
+};
+
+template <typename Traits, typename = void>
+struct nesting_stack_selector
+{
+    using type = dynamic_nesting_stack;
+};
+template <typename Traits>
+struct nesting_stack_selector<Traits, std::void_t<decltype(Traits::max_depth)>>
+{
+    using type = fixed_nesting_stack<Traits::max_depth>;
+};
+
+template <typename Traits>
+using nesting_stack = typename nesting_stack_selector<Traits>::type;
+}  // namespace detail
+}  // namespace async_json
+
+#endif
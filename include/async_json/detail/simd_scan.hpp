@@ -0,0 +1,273 @@
+/* ==========================================================================
+ Copyright (c) 2024 Andreas Pokorny
+ Distributed under the Boost Software License, Version 1.0. (See accompanying
+ file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+========================================================================== */
+
+#ifndef ASYNC_JSON_DETAIL_SIMD_SCAN_HPP_INCLUDED
+#define ASYNC_JSON_DETAIL_SIMD_SCAN_HPP_INCLUDED
+
+#include <cstdint>
+#include <cstring>
+
+#if !defined(ASYNC_JSON_DISABLE_SIMD)
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define ASYNC_JSON_SIMD_AVX2
+#define ASYNC_JSON_SIMD_SSE2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ASYNC_JSON_SIMD_SSE2
+#endif
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+namespace async_json
+{
+namespace detail
+{
+inline unsigned first_set_bit(std::uint32_t mask) noexcept
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return static_cast<unsigned>(index);
+#else
+    return static_cast<unsigned>(__builtin_ctz(mask));
+#endif
+}
+
+inline unsigned first_set_bit(std::uint64_t mask) noexcept
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long index;
+    _BitScanForward64(&index, mask);
+    return static_cast<unsigned>(index);
+#else
+    return static_cast<unsigned>(__builtin_ctzll(mask));
+#endif
+}
+
+constexpr std::uint64_t broadcast(char c) noexcept { return 0x0101010101010101ull * static_cast<unsigned char>(c); }
+
+// SWAR: sets the high bit of every byte in v that is zero
+constexpr std::uint64_t zero_bytes(std::uint64_t v) noexcept { return (v - 0x0101010101010101ull) & ~v & 0x8080808080808080ull; }
+
+inline std::uint64_t load_u64(char const* p) noexcept
+{
+    std::uint64_t v;
+    std::memcpy(&v, p, sizeof v);
+    return v;
+}
+
+// loads eight bytes so that the first byte ends up in the least significant position
+inline std::uint64_t load_u64_le(char const* p) noexcept
+{
+    auto v = load_u64(p);
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    v = __builtin_bswap64(v);
+#endif
+    return v;
+}
+
+/// Returns a pointer to the first '"' or '\\' in [first, last), or last if there is none.
+inline char const* find_quote_or_escape(char const* first, char const* last) noexcept
+{
+#if defined(ASYNC_JSON_SIMD_AVX2)
+    auto const quot32 = _mm256_set1_epi8('"');
+    auto const esc32  = _mm256_set1_epi8('\\');
+    for (; last - first >= 32; first += 32)
+    {
+        auto const block = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(first));
+        auto const mask  = static_cast<std::uint32_t>(
+            _mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(block, quot32), _mm256_cmpeq_epi8(block, esc32))));
+        if (mask) return first + first_set_bit(mask);
+    }
+#endif
+#if defined(ASYNC_JSON_SIMD_SSE2)
+    auto const quot16 = _mm_set1_epi8('"');
+    auto const esc16  = _mm_set1_epi8('\\');
+    for (; last - first >= 16; first += 16)
+    {
+        auto const block = _mm_loadu_si128(reinterpret_cast<__m128i const*>(first));
+        auto const mask =
+            static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(block, quot16), _mm_cmpeq_epi8(block, esc16))));
+        if (mask) return first + first_set_bit(mask);
+    }
+#else
+    for (; last - first >= 8; first += 8)
+    {
+        auto const v    = load_u64(first);
+        auto const mask = zero_bytes(v ^ broadcast('"')) | zero_bytes(v ^ broadcast('\\'));
+        if (mask) break;
+    }
+#endif
+    while (first != last && *first != '"' && *first != '\\') ++first;
+    return first;
+}
+
+/// Returns a pointer to the first '\\' in [first, last), or last if there is none.
+inline char const* find_escape(char const* first, char const* last) noexcept
+{
+#if defined(ASYNC_JSON_SIMD_AVX2)
+    auto const esc32 = _mm256_set1_epi8('\\');
+    for (; last - first >= 32; first += 32)
+    {
+        auto const block = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(first));
+        auto const mask  = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, esc32)));
+        if (mask) return first + first_set_bit(mask);
+    }
+#endif
+#if defined(ASYNC_JSON_SIMD_SSE2)
+    auto const esc16 = _mm_set1_epi8('\\');
+    for (; last - first >= 16; first += 16)
+    {
+        auto const block = _mm_loadu_si128(reinterpret_cast<__m128i const*>(first));
+        auto const mask  = static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, esc16)));
+        if (mask) return first + first_set_bit(mask);
+    }
+#else
+    for (; last - first >= 8; first += 8)
+        if (zero_bytes(load_u64(first) ^ broadcast('\\'))) break;
+#endif
+    while (first != last && *first != '\\') ++first;
+    return first;
+}
+
+constexpr bool is_quote_or_bracket(char c) noexcept
+{
+    // setting bit 5 maps '[' to '{' and ']' to '}'
+    return c == '"' || (c | 0x20) == '{' || (c | 0x20) == '}';
+}
+
+/// Returns a pointer to the first '"', '{', '}', '[' or ']' in [first, last), or last if there is none.
+inline char const* find_quote_or_bracket(char const* first, char const* last) noexcept
+{
+#if defined(ASYNC_JSON_SIMD_AVX2)
+    auto const quot32  = _mm256_set1_epi8('"');
+    auto const bit32   = _mm256_set1_epi8(0x20);
+    auto const open32  = _mm256_set1_epi8('{');
+    auto const close32 = _mm256_set1_epi8('}');
+    for (; last - first >= 32; first += 32)
+    {
+        auto const block  = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(first));
+        auto const folded = _mm256_or_si256(block, bit32);
+        auto const mask   = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_or_si256(
+            _mm256_cmpeq_epi8(block, quot32), _mm256_or_si256(_mm256_cmpeq_epi8(folded, open32), _mm256_cmpeq_epi8(folded, close32)))));
+        if (mask) return first + first_set_bit(mask);
+    }
+#endif
+#if defined(ASYNC_JSON_SIMD_SSE2)
+    auto const quot16  = _mm_set1_epi8('"');
+    auto const bit16   = _mm_set1_epi8(0x20);
+    auto const open16  = _mm_set1_epi8('{');
+    auto const close16 = _mm_set1_epi8('}');
+    for (; last - first >= 16; first += 16)
+    {
+        auto const block  = _mm_loadu_si128(reinterpret_cast<__m128i const*>(first));
+        auto const folded = _mm_or_si128(block, bit16);
+        auto const mask   = static_cast<std::uint32_t>(_mm_movemask_epi8(
+            _mm_or_si128(_mm_cmpeq_epi8(block, quot16), _mm_or_si128(_mm_cmpeq_epi8(folded, open16), _mm_cmpeq_epi8(folded, close16)))));
+        if (mask) return first + first_set_bit(mask);
+    }
+#else
+    for (; last - first >= 8; first += 8)
+    {
+        auto const v      = load_u64(first);
+        auto const folded = v | broadcast(0x20);
+        auto const mask   = zero_bytes(v ^ broadcast('"')) | zero_bytes(folded ^ broadcast('{')) | zero_bytes(folded ^ broadcast('}'));
+        if (mask) break;
+    }
+#endif
+    while (first != last && !is_quote_or_bracket(*first)) ++first;
+    return first;
+}
+
+constexpr bool is_whitespace(char c) noexcept { return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\b'; }
+
+/// Returns a pointer to the first byte in [first, last) that is not whitespace, or last if there is none.
+inline char const* skip_whitespace(char const* first, char const* last) noexcept
+{
+    // indentation runs are usually short, so check the first byte before setting up a block compare
+    if (first == last || !is_whitespace(*first)) return first;
+#if defined(ASYNC_JSON_SIMD_AVX2)
+    auto const space32 = _mm256_set1_epi8(' ');
+    auto const nl32    = _mm256_set1_epi8('\n');
+    auto const tab32   = _mm256_set1_epi8('\t');
+    auto const cr32    = _mm256_set1_epi8('\r');
+    auto const bs32    = _mm256_set1_epi8('\b');
+    for (; last - first >= 32; first += 32)
+    {
+        auto const block = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(first));
+        auto const ws    = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(block, space32), _mm256_cmpeq_epi8(block, nl32)),
+                                           _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(block, tab32), _mm256_cmpeq_epi8(block, cr32)),
+                                                           _mm256_cmpeq_epi8(block, bs32)));
+        auto const mask  = ~static_cast<std::uint32_t>(_mm256_movemask_epi8(ws));
+        if (mask) return first + first_set_bit(mask);
+    }
+#endif
+#if defined(ASYNC_JSON_SIMD_SSE2)
+    auto const space16 = _mm_set1_epi8(' ');
+    auto const nl16    = _mm_set1_epi8('\n');
+    auto const tab16   = _mm_set1_epi8('\t');
+    auto const cr16    = _mm_set1_epi8('\r');
+    auto const bs16    = _mm_set1_epi8('\b');
+    for (; last - first >= 16; first += 16)
+    {
+        auto const block = _mm_loadu_si128(reinterpret_cast<__m128i const*>(first));
+        auto const ws    = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(block, space16), _mm_cmpeq_epi8(block, nl16)),
+                                        _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(block, tab16), _mm_cmpeq_epi8(block, cr16)),
+                                                     _mm_cmpeq_epi8(block, bs16)));
+        auto const mask  = ~static_cast<std::uint32_t>(_mm_movemask_epi8(ws)) & 0xFFFFu;
+        if (mask) return first + first_set_bit(mask);
+    }
+#endif
+    while (first != last && is_whitespace(*first)) ++first;
+    return first;
+}
+
+// compares four bytes at p with the first four characters of str in one unaligned load
+inline bool equals_four(char const* p, char const* str) noexcept
+{
+    std::uint32_t a, b;
+    std::memcpy(&a, p, sizeof a);
+    std::memcpy(&b, str, sizeof b);
+    return a == b;
+}
+
+constexpr bool is_digit(char c) noexcept { return c >= '0' && c <= '9'; }
+
+// true if all eight bytes of a little endian loaded word are ASCII digits
+constexpr bool is_eight_digits(std::uint64_t v) noexcept
+{
+    return ((v & 0xF0F0F0F0F0F0F0F0ull) | (((v + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull) >> 4)) == 0x3333333333333333ull;
+}
+
+// converts eight ASCII digits of a little endian loaded word with three multiplications
+constexpr std::uint32_t parse_eight_digits(std::uint64_t v) noexcept
+{
+    constexpr std::uint64_t mask = 0x000000FF000000FFull;
+    constexpr std::uint64_t mul1 = 0x000F424000000064ull;  // 100 + (1000000 << 32)
+    constexpr std::uint64_t mul2 = 0x0000271000000001ull;  // 1 + (10000 << 32)
+    v -= 0x3030303030303030ull;
+    v = (v * 10) + (v >> 8);
+    v = (((v & mask) * mul1) + (((v >> 16) & mask) * mul2)) >> 32;
+    return static_cast<std::uint32_t>(v);
+}
+
+/// Returns a pointer to the first byte in [first, last) that is not a digit, or last if there is none.
+inline char const* skip_digits(char const* first, char const* last) noexcept
+{
+    for (; last - first >= 8; first += 8)
+        if (!is_eight_digits(load_u64_le(first))) break;
+    while (first != last && is_digit(*first)) ++first;
+    return first;
+}
+
+}  // namespace detail
+}  // namespace async_json
+
+#endif
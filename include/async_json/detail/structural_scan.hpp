@@ -0,0 +1,177 @@
+/* ==========================================================================
+ Copyright (c) 2024 Andreas Pokorny
+ Distributed under the Boost Software License, Version 1.0. (See accompanying
+ file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+========================================================================== */
+
+#ifndef ASYNC_JSON_DETAIL_STRUCTURAL_SCAN_HPP_INCLUDED
+#define ASYNC_JSON_DETAIL_STRUCTURAL_SCAN_HPP_INCLUDED
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include <async_json/detail/simd_scan.hpp>
+
+namespace async_json
+{
+namespace detail
+{
+// one bit per byte of a 64 byte block
+struct block_masks
+{
+    std::uint64_t quote{0};
+    std::uint64_t backslash{0};
+    std::uint64_t op{0};  // {}[]:,
+    std::uint64_t ws{0};
+};
+
+#if defined(ASYNC_JSON_SIMD_SSE2)
+inline std::uint64_t movemask16(__m128i v) noexcept { return static_cast<std::uint64_t>(static_cast<std::uint32_t>(_mm_movemask_epi8(v)) & 0xFFFFu); }
+#endif
+
+inline block_masks classify_block(char const* p) noexcept
+{
+    block_masks m;
+#if defined(ASYNC_JSON_SIMD_SSE2)
+    auto const quot   = _mm_set1_epi8('"');
+    auto const esc    = _mm_set1_epi8('\\');
+    auto const br_o   = _mm_set1_epi8('{');
+    auto const br_c   = _mm_set1_epi8('}');
+    auto const idx_o  = _mm_set1_epi8('[');
+    auto const idx_c  = _mm_set1_epi8(']');
+    auto const colon  = _mm_set1_epi8(':');
+    auto const comma  = _mm_set1_epi8(',');
+    auto const space  = _mm_set1_epi8(' ');
+    auto const nl     = _mm_set1_epi8('\n');
+    auto const tab    = _mm_set1_epi8('\t');
+    auto const cr     = _mm_set1_epi8('\r');
+    auto const bs     = _mm_set1_epi8('\b');
+    for (unsigned i = 0; i != 4; ++i)
+    {
+        auto const block = _mm_loadu_si128(reinterpret_cast<__m128i const*>(p + 16 * i));
+        auto const op    = _mm_or_si128(
+            _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(block, br_o), _mm_cmpeq_epi8(block, br_c)),
+                         _mm_or_si128(_mm_cmpeq_epi8(block, idx_o), _mm_cmpeq_epi8(block, idx_c))),
+            _mm_or_si128(_mm_cmpeq_epi8(block, colon), _mm_cmpeq_epi8(block, comma)));
+        auto const ws = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(block, space), _mm_cmpeq_epi8(block, nl)),
+                                     _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(block, tab), _mm_cmpeq_epi8(block, cr)),
+                                                  _mm_cmpeq_epi8(block, bs)));
+        m.quote |= movemask16(_mm_cmpeq_epi8(block, quot)) << (16 * i);
+        m.backslash |= movemask16(_mm_cmpeq_epi8(block, esc)) << (16 * i);
+        m.op |= movemask16(op) << (16 * i);
+        m.ws |= movemask16(ws) << (16 * i);
+    }
+#else
+    for (unsigned i = 0; i != 64; ++i)
+    {
+        auto const bit = std::uint64_t{1} << i;
+        switch (p[i])
+        {
+            case '"': m.quote |= bit; break;
+            case '\\': m.backslash |= bit; break;
+            case '{':
+            case '}':
+            case '[':
+            case ']':
+            case ':':
+            case ',': m.op |= bit; break;
+            case ' ':
+            case '\n':
+            case '\t':
+            case '\r':
+            case '\b': m.ws |= bit; break;
+            default: break;
+        }
+    }
+#endif
+    return m;
+}
+
+// bit i of the result is the xor of the bits 0 to i of x
+constexpr std::uint64_t prefix_xor(std::uint64_t x) noexcept
+{
+    x ^= x << 1;
+    x ^= x << 2;
+    x ^= x << 4;
+    x ^= x << 8;
+    x ^= x << 16;
+    x ^= x << 32;
+    return x;
+}
+
+// Stage one of the indexed parser: finds the structural characters of a document block by block.
+// Reported are {}[]:, outside of strings, opening and closing quotes and the first byte of every number or keyword.
+class structural_scanner
+{
+   public:
+    // returns the structural positions of the block as bit mask
+    std::uint64_t next(block_masks const& m) noexcept
+    {
+        auto const escaped = escaped_characters(m.backslash);
+        auto const quotes  = m.quote & ~escaped;
+        auto const in_str  = prefix_xor(quotes) ^ prev_in_string;
+        prev_in_string     = static_cast<std::uint64_t>(static_cast<std::int64_t>(in_str) >> 63);
+        // closing quotes are outside of the string, opening quotes inside
+        auto const outside = ~in_str;
+        auto const ops     = m.op & outside;
+        auto const ends    = ops | (m.ws & outside) | (quotes & outside);
+        auto const scalars = ((ends << 1) | prev_end) & outside & ~(m.op | m.ws | quotes);
+        prev_end           = ends >> 63;
+        return ops | quotes | scalars;
+    }
+    bool inside_string() const noexcept { return prev_in_string != 0; }
+
+   private:
+    // marks every character preceded by an odd number of backslashes
+    std::uint64_t escaped_characters(std::uint64_t backslash) noexcept
+    {
+        constexpr std::uint64_t even_bits = 0x5555555555555555ull;
+        constexpr std::uint64_t odd_bits  = ~even_bits;
+
+        auto const start_edges     = backslash & ~(backslash << 1);
+        auto const even_start_mask = even_bits ^ prev_odd_backslash;
+        auto const even_starts     = start_edges & even_start_mask;
+        auto const odd_starts      = start_edges & ~even_start_mask;
+        auto const even_carries    = backslash + even_starts;
+        auto       odd_carries     = backslash + odd_starts;
+        bool const ends_odd        = odd_carries < backslash;
+        odd_carries |= prev_odd_backslash;
+        prev_odd_backslash = ends_odd ? 1 : 0;
+
+        auto const even_carry_ends = even_carries & ~backslash;
+        auto const odd_carry_ends  = odd_carries & ~backslash;
+        return (even_carry_ends & odd_bits) | (odd_carry_ends & even_bits);
+    }
+
+    std::uint64_t prev_odd_backslash{0};
+    std::uint64_t prev_in_string{0};
+    std::uint64_t prev_end{1};  // the start of the document delimits a token
+};
+
+/// Appends the offsets of all structural characters of [first, first + size) to positions, counted from first - base.
+/// Returns false if the input ends within a string.
+inline bool find_structurals(char const* first, std::size_t size, std::vector<std::uint32_t>& positions, std::uint32_t base = 0)
+{
+    structural_scanner scanner;
+    auto const         append = [&positions](std::uint64_t mask, std::uint32_t block)
+    {
+        for (; mask; mask &= mask - 1) positions.push_back(block + first_set_bit(mask));
+    };
+    std::size_t offset = 0;
+    for (; size - offset >= 64; offset += 64)
+        append(scanner.next(classify_block(first + offset)), base + static_cast<std::uint32_t>(offset));
+    if (offset != size)
+    {
+        char tail[64];
+        std::memset(tail, ' ', sizeof tail);
+        std::memcpy(tail, first + offset, size - offset);
+        append(scanner.next(classify_block(tail)), base + static_cast<std::uint32_t>(offset));
+    }
+    return !scanner.inside_string();
+}
+
+}  // namespace detail
+}  // namespace async_json
+
+#endif
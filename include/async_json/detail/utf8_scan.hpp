@@ -0,0 +1,81 @@
+/* ==========================================================================
+ Copyright (c) 2024 Andreas Pokorny
+ Distributed under the Boost Software License, Version 1.0. (See accompanying
+ file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+========================================================================== */
+
+#ifndef ASYNC_JSON_DETAIL_UTF8_SCAN_HPP_INCLUDED
+#define ASYNC_JSON_DETAIL_UTF8_SCAN_HPP_INCLUDED
+
+#include <cstdint>
+#include <async_json/detail/simd_scan.hpp>
+
+namespace async_json
+{
+namespace detail
+{
+/// Returns a pointer to the first byte in [first, last) with the high bit set, or last if there is none.
+inline char const* skip_ascii(char const* first, char const* last) noexcept
+{
+#if defined(ASYNC_JSON_SIMD_AVX2)
+    for (; last - first >= 32; first += 32)
+    {
+        auto const mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_loadu_si256(reinterpret_cast<__m256i const*>(first))));
+        if (mask) return first + first_set_bit(mask);
+    }
+#endif
+#if defined(ASYNC_JSON_SIMD_SSE2)
+    for (; last - first >= 16; first += 16)
+    {
+        auto const mask = static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<__m128i const*>(first))));
+        if (mask) return first + first_set_bit(mask);
+    }
+#else
+    for (; last - first >= 8; first += 8)
+        if (load_u64(first) & 0x8080808080808080ull) break;
+#endif
+    while (first != last && static_cast<unsigned char>(*first) < 0x80) ++first;
+    return first;
+}
+
+/// Position within a multi byte sequence, kept between the parts of a string.
+struct utf8_state
+{
+    std::uint8_t pending{0};  ///< continuation bytes still expected
+    std::uint8_t lo{0x80};    ///< range of the next continuation byte, narrower after E0, ED, F0 and F4
+    std::uint8_t hi{0xBF};
+
+    constexpr bool complete() const noexcept { return pending == 0; }
+};
+
+/// Checks that [first, last) continues valid UTF-8 from state, sequences may be split between calls.
+/// Overlong forms, surrogates and code points beyond U+10FFFF are rejected.
+inline bool validate_utf8(char const* first, char const* last, utf8_state& state) noexcept
+{
+    while (first != last)
+    {
+        if (state.complete())
+        {
+            // ASCII runs are skipped block wise, only multi byte sequences are checked byte by byte
+            first = skip_ascii(first, last);
+            if (first == last) break;
+            auto const lead = static_cast<unsigned char>(*first++);
+            if (lead < 0xC2 || lead > 0xF4) return false;
+            state.pending = lead < 0xE0 ? 1 : lead < 0xF0 ? 2 : 3;
+            state.lo      = lead == 0xE0 ? 0xA0 : lead == 0xF0 ? 0x90 : 0x80;
+            state.hi      = lead == 0xED ? 0x9F : lead == 0xF4 ? 0x8F : 0xBF;
+            continue;
+        }
+        auto const c = static_cast<unsigned char>(*first++);
+        if (c < state.lo || c > state.hi) return false;
+        state.lo = 0x80;
+        state.hi = 0xBF;
+        --state.pending;
+    }
+    return true;
+}
+
+}  // namespace detail
+}  // namespace async_json
+
+#endif
@@ -0,0 +1,163 @@
+/* ==========================================================================
+ Copyright (c) 2024 Andreas Pokorny
+ Distributed under the Boost Software License, Version 1.0. (See accompanying
+ file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+========================================================================== */
+
+#ifndef ASYNC_JSON_EVENT_STREAM_HPP_INCLUDED
+#define ASYNC_JSON_EVENT_STREAM_HPP_INCLUDED
+
+#include <array>
+#include <cassert>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <utility>
+#include <async_json/basic_json_parser.hpp>
+
+namespace async_json
+{
+/// Lazily pulled stream of parser events, produced by parse_events.
+/// Events are obtained with co_await stream.next(), which yields a pointer to the next event or nullptr at the end
+/// of the stream. The event and the string views within it stay valid until next() is awaited again.
+template <typename Traits = default_traits>
+class event_stream
+{
+   public:
+    using event_value = saj_event_value<Traits>;
+
+    struct promise_type
+    {
+        event_value const*      current{nullptr};
+        std::coroutine_handle<> consumer;
+        std::exception_ptr      error;
+
+        event_stream        get_return_object() noexcept { return event_stream{handle_t::from_promise(*this)}; }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        auto                final_suspend() noexcept { return resume_consumer{}; }
+        auto                yield_value(event_value const& ev) noexcept
+        {
+            current = &ev;
+            return resume_consumer{};
+        }
+        void return_void() noexcept { current = nullptr; }
+        void unhandled_exception() noexcept
+        {
+            error   = std::current_exception();
+            current = nullptr;
+        }
+    };
+    using handle_t = std::coroutine_handle<promise_type>;
+
+    struct resume_consumer
+    {
+        bool                    await_ready() const noexcept { return false; }
+        std::coroutine_handle<> await_suspend(handle_t producer) noexcept { return producer.promise().consumer; }
+        void                    await_resume() const noexcept {}
+    };
+
+    struct next_awaiter
+    {
+        handle_t producer;
+
+        bool                    await_ready() const noexcept { return producer.done(); }
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<> consumer) noexcept
+        {
+            producer.promise().consumer = consumer;
+            return producer;
+        }
+        event_value const* await_resume() const
+        {
+            if (producer.promise().error) std::rethrow_exception(std::exchange(producer.promise().error, nullptr));
+            return producer.promise().current;
+        }
+    };
+
+    event_stream(event_stream&& other) noexcept : coro(std::exchange(other.coro, nullptr)) {}
+    event_stream& operator=(event_stream&& other) noexcept
+    {
+        if (this != &other)
+        {
+            if (coro) coro.destroy();
+            coro = std::exchange(other.coro, nullptr);
+        }
+        return *this;
+    }
+    event_stream(event_stream const&)            = delete;
+    event_stream& operator=(event_stream const&) = delete;
+    ~event_stream()
+    {
+        if (coro) coro.destroy();
+    }
+
+    next_awaiter next() noexcept { return next_awaiter{coro}; }
+
+   private:
+    explicit event_stream(handle_t h) noexcept : coro(h) {}
+    handle_t coro;
+};
+
+namespace detail
+{
+// Parser handler that holds the events of a single token and suspends the parser as soon as there is one.
+template <typename Traits>
+struct pending_events
+{
+    using event_value = saj_event_value<Traits>;
+
+    // a token emits at most four events, the last part of a raw number, number_value_end, object_end and document_end
+    std::array<event_value, 4> events;
+    std::size_t                size{0};
+
+    void operator()(event_value const& ev)
+    {
+        assert(size < events.size());
+        events[size++] = ev;
+    }
+    bool suspend_requested() const noexcept { return size != 0; }
+};
+}  // namespace detail
+
+/// Parses a single json value, or with multi document traits all values, read from source and yields their events.
+/// source() has to return an awaitable that produces the next chunk of input as a string view, an empty view marks
+/// the end of the input. A chunk has to stay valid until source() is called again. The producer is resumed by
+/// whoever completes that awaitable, so it runs on the executor of the byte source.
+/// When the input ends within a value the stream ends with a parse_error event with incomplete_input.
+template <typename Traits = default_traits, typename InterpreterTag = table_tag, typename ByteSource>
+event_stream<Traits> parse_events(ByteSource source)
+{
+    using sv_t = typename Traits::sv_t;
+    basic_json_parser<detail::pending_events<Traits>, Traits, InterpreterTag> parser;
+    auto&        pending = *parser.callback_handler();
+    parse_result ret{parse_status::done, 0};
+    for (;;)
+    {
+        sv_t rest = co_await source();
+        if (rest.empty()) break;
+        do
+        {
+            ret = parser.parse_some(rest);
+            for (std::size_t i = 0; i != pending.size; ++i) co_yield pending.events[i];
+            pending.size = 0;
+            rest         = rest.substr(ret.consumed);
+        } while (ret.status == parse_status::suspended);
+        if (ret.status == parse_status::error) co_return;
+        // in multi document mode the stream continues until the end of the input
+        if constexpr (!detail::has_multi_document<Traits>::value)
+        {
+            if (ret.status == parse_status::done) co_return;
+        }
+    }
+    if (ret.status != parse_status::need_more) co_return;
+    // completes a number at the top level or reports the incomplete value
+    do
+    {
+        ret = parser.finish();
+        for (std::size_t i = 0; i != pending.size; ++i) co_yield pending.events[i];
+        pending.size = 0;
+    } while (ret.status == parse_status::suspended);
+}
+
+}  // namespace async_json
+
+#endif
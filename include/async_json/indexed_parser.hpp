@@ -0,0 +1,339 @@
+/* ==========================================================================
+ Copyright (c) 2024 Andreas Pokorny
+ Distributed under the Boost Software License, Version 1.0. (See accompanying
+ file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+========================================================================== */
+
+#ifndef ASYNC_JSON_INDEXED_PARSER_HPP_INCLUDED
+#define ASYNC_JSON_INDEXED_PARSER_HPP_INCLUDED
+
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+#include <async_json/basic_json_parser.hpp>
+#include <async_json/number_converter.hpp>
+#include <async_json/detail/nesting_stack.hpp>
+#include <async_json/detail/structural_scan.hpp>
+
+namespace async_json
+{
+namespace detail
+{
+// Integers beyond unsigned long long wrap around in basic_json_parser, the same value is reported here.
+template <typename Integer, typename Sv>
+Integer wrapped_integer(Sv number) noexcept
+{
+    unsigned long long magnitude = 0;
+    for (auto c : number)
+        if (is_digit(c)) magnitude = magnitude * 10 + static_cast<unsigned>(c - '0');
+    return (number[0] == '-' ? -1 : 1) * static_cast<Integer>(magnitude);
+}
+
+// Stage two of the indexed parser: walks the structural positions from first on and emits the same events as
+// basic_json_parser. consumed of the result is the offset of the structural position that ended the walk, with
+// multi_document the caller continues after an error on the next line.
+// Decoded strings and names are views of scratch, which is owned by the caller so that it outlives a flush() of the handler.
+template <typename Traits, typename Handler>
+parse_result walk_structurals(typename Traits::sv_t document, std::vector<std::uint32_t> const& positions, Handler& handler,
+                              std::string& scratch, std::size_t first = 0)
+{
+    using event_value = saj_event_value<Traits>;
+    using sv_t        = typename Traits::sv_t;
+    enum class expect
+    {
+        value,
+        first_element,
+        member,
+        after_value
+    };
+
+    constexpr bool multi_document = has_multi_document<Traits>::value;
+
+    nesting_stack<Traits> stack;
+    auto                  state       = expect::value;
+    bool                  in_document = false;
+    auto const            count       = positions.size();
+    std::size_t           i           = first;
+    auto const            at          = [&](parse_status status)
+    {
+        return parse_result{status, i < count ? std::size_t{positions[i]} : document.size()};
+    };
+    auto const            fail        = [&](error_cause cause)
+    {
+        handler(event_value(saj_event::parse_error, cause));
+        if constexpr (multi_document) handler(event_value(saj_event::document_end));
+        return at(parse_status::error);
+    };
+    // numbers and keywords end at the next structural position
+    auto const scalar = [&](std::size_t index)
+    {
+        std::size_t const first = positions[index];
+        std::size_t       last  = index + 1 < count ? positions[index + 1] : document.size();
+        while (last != first && is_whitespace(document[last - 1])) --last;
+        return document.substr(first, last - first);
+    };
+    // with validate_utf8 strings and names are checked, with decode_escapes those that contain escape sequences are
+    // replaced by their decoded copy
+    auto const check_text = [&](sv_t& text) -> error_cause
+    {
+        auto const first = text.data();
+        auto const last  = first + text.size();
+        if constexpr (has_validate_utf8<Traits>::value)
+        {
+            utf8_state state;
+            if (!validate_utf8(first, last, state) || !state.complete()) return invalid_utf8;
+        }
+        if constexpr (has_decode_escapes<Traits>::value)
+        {
+            if (find_escape(first, last) == last) return no_error;
+            scratch.resize(text.size());
+            auto const ret = json_to_utf8(std::string_view(first, text.size()), scratch.data());
+            if (ret.status != decode_status::ok) return invalid_escape;
+            text = sv_t(scratch.data(), ret.written);
+        }
+        return no_error;
+    };
+
+    while (i != count)
+    {
+        auto const c = document[positions[i]];
+        if constexpr (multi_document)
+        {
+            if (!in_document)
+            {
+                handler(event_value(saj_event::document_start));
+                in_document = true;
+            }
+        }
+        switch (state)
+        {
+            case expect::first_element:
+                if (c == ']')
+                {
+                    stack.pop_back();
+                    handler(event_value(saj_event::array_end));
+                    ++i;
+                    state = expect::after_value;
+                    break;
+                }
+                [[fallthrough]];
+            case expect::value:
+                switch (c)
+                {
+                    case '{':
+                    case '[':
+                        if (stack.full()) return fail(nesting_too_deep);
+                        handler(event_value(c == '{' ? saj_event::object_start : saj_event::array_start));
+                        stack.push_back(c == '{' ? 0 : 1);
+                        state = c == '{' ? expect::member : expect::first_element;
+                        ++i;
+                        break;
+                    case '"':
+                    {
+                        if (i + 1 == count) return at(parse_status::need_more);
+                        auto const first = positions[i] + 1;
+                        auto       text  = document.substr(first, positions[i + 1] - first);
+                        if (auto const cause = check_text(text); cause != no_error) return fail(cause);
+                        handler(event_value(saj_event::string_value_start, text));
+                        handler(event_value(saj_event::string_value_end));
+                        i += 2;
+                        state = expect::after_value;
+                        break;
+                    }
+                    case 't':
+                    case 'f':
+                    case 'n':
+                    {
+                        auto const kw = scalar(i);
+                        if (kw == sv_t("true"))
+                            handler(event_value(saj_event::boolean_value, true));
+                        else if (kw == sv_t("false"))
+                            handler(event_value(saj_event::boolean_value, false));
+                        else if (kw == sv_t("null"))
+                            handler(event_value());
+                        else
+                            return fail(wrong_keyword_character);
+                        ++i;
+                        state = expect::after_value;
+                        break;
+                    }
+                    default:
+                    {
+                        if (c != '-' && !is_digit(c)) return fail(unexpected_character);
+                        auto number = scalar(i);
+                        // whitespace between the minus and the digits is accepted by basic_json_parser, the digits
+                        // are a structural position of their own then
+                        if (number.size() == 1 && c == '-' && i + 1 < count && is_digit(document[positions[i + 1]]))
+                        {
+                            auto const digits = scalar(++i);
+                            number            = document.substr(positions[i - 1], positions[i] + digits.size() - positions[i - 1]);
+                        }
+                        if constexpr (has_raw_numbers<Traits>::value)
+                        {
+                            handler(event_value(saj_event::number_value_start, number));
+                            handler(event_value(saj_event::number_value_end));
+                        }
+                        else
+                        {
+                            typename Traits::integer_t integer{};
+                            typename Traits::float_t   fraction{};
+                            bool const                 is_float = number.find_first_of(".eE") != sv_t::npos;
+                            auto const integer_status = is_float ? conversion_status::invalid : to_integer(number, integer);
+                            if (integer_status == conversion_status::out_of_range)
+                                integer = wrapped_integer<typename Traits::integer_t>(number);
+                            if (integer_status != conversion_status::invalid)
+                                handler(event_value(saj_event::integer_value, integer));
+                            else if (to_float(number, fraction) != conversion_status::invalid)
+                                handler(event_value(saj_event::float_value, fraction));
+                            else
+                                return fail(invalid_number);
+                        }
+                        // basic_json_parser passes the bracket that ends a number to the top level, where nothing is open
+                        auto const end = static_cast<std::size_t>(number.data() - document.data()) + number.size();
+                        if (stack.empty() && i + 1 < count && positions[i + 1] == end)
+                        {
+                            if (document[end] == ']') return fail(mismatched_array);
+                            if (document[end] == '}') return fail(mismatched_brace);
+                        }
+                        ++i;
+                        state = expect::after_value;
+                        break;
+                    }
+                }
+                break;
+            case expect::member:
+                if (c == '}')
+                {
+                    stack.pop_back();
+                    handler(event_value(saj_event::object_end));
+                    ++i;
+                    state = expect::after_value;
+                    break;
+                }
+                if (c != '"') return fail(member_exp);
+                if (i + 1 == count) return at(parse_status::need_more);
+                {
+                    auto const first = positions[i] + 1;
+                    auto       name  = document.substr(first, positions[i + 1] - first);
+                    if (auto const cause = check_text(name); cause != no_error) return fail(cause);
+                    handler(event_value(saj_event::object_name_start, name));
+                    if constexpr (has_name_hashes<Traits>::value)
+                        handler(event_value::name_end(hash_name(std::string_view(name.data(), name.size()))));
+                    else
+                        handler(event_value(saj_event::object_name_end));
+                }
+                i += 2;
+                if (i == count) return at(parse_status::need_more);
+                if (document[positions[i]] != ':') return fail(colon_exp);
+                ++i;
+                state = expect::value;
+                break;
+            case expect::after_value:
+                switch (c)
+                {
+                    case ',':
+                        state = stack.back() == 0 ? expect::member : expect::value;
+                        ++i;
+                        break;
+                    case '}':
+                        if (stack.back() != 0) return fail(mismatched_brace);
+                        stack.pop_back();
+                        handler(event_value(saj_event::object_end));
+                        ++i;
+                        break;
+                    case ']':
+                        if (stack.back() != 1) return fail(mismatched_array);
+                        stack.pop_back();
+                        handler(event_value(saj_event::array_end));
+                        ++i;
+                        break;
+                    default: return fail(comma_expected);
+                }
+                break;
+        }
+        if (state == expect::after_value && stack.empty())
+        {
+            // like basic_json_parser everything after the top level value is ignored, unless it is a multi document
+            // stream then the next value starts a new document
+            if constexpr (!multi_document) return at(parse_status::done);
+            handler(event_value(saj_event::document_end));
+            in_document = false;
+            state       = expect::value;
+        }
+    }
+    // also reached when the document ends within a string, the opening quote is the last position then
+    return at(in_document || !multi_document ? parse_status::need_more : parse_status::done);
+}
+}  // namespace detail
+
+/// Parses a document that is completely in memory in two stages and passes the events to the handler of parser.
+/// The first stage collects the positions of all structural characters with block wise SIMD compares, the second
+/// stage walks those positions instead of the individual bytes. The events are the same as with parser.parse_bytes,
+/// except that strings, names and numbers are always reported in a single part.
+/// With decode_escapes and validate_utf8 strings and names are decoded and checked like in basic_json_parser, with
+/// multi_document every value is framed by document_start and document_end, and a parse error skips the rest of its
+/// line without scanning the document again. Numbers that basic_json_parser only completes at the next delimiter are
+/// also reported at the end of the document. Malformed numbers like "1." or "-" that basic_json_parser emits as numbers
+/// are reported as errors, and a comma right after a number at the top level, where basic_json_parser waits for more
+/// input, ends the value.
+/// Documents of 4 GiB or more are handed to parser.parse_some instead.
+template <typename Handler, typename Traits, typename IT>
+parse_status parse_indexed(typename Traits::sv_t document, basic_json_parser<Handler, Traits, IT>& parser)
+{
+    if (document.size() >= std::numeric_limits<std::uint32_t>::max())
+    {
+        parser.reset();
+        return parser.parse_some(document).status;
+    }
+    std::vector<std::uint32_t> indexes[2];
+    indexes[0].reserve(document.size() / 4);
+    detail::find_structurals(document.data(), document.size(), indexes[0]);
+    std::string scratch;
+    auto&       handler = *parser.callback_handler();
+    auto        result  = detail::walk_structurals<Traits>(document, indexes[0], handler, scratch);
+    if constexpr (detail::has_multi_document<Traits>::value)
+    {
+        // The rest of the line of an error is skipped. The index is still valid on the next line if the line break is
+        // outside of a string. Otherwise a scan that starts on the next line finds the same quotes with inside and
+        // outside swapped, also on every later line, so a second index is scanned once and the two are used in turn.
+        std::size_t cursor[2]     = {0, 0};  // positions before the current line, their quotes are counted
+        bool        in_string[2]  = {false, false};
+        bool        swapped_ready = false;
+        int         active        = 0;
+        auto const  in_string_at  = [&](int index, std::uint32_t line)
+        {
+            auto const& positions = indexes[index];
+            for (; cursor[index] != positions.size() && positions[cursor[index]] < line; ++cursor[index])
+                if (document[positions[cursor[index]]] == '"') in_string[index] = !in_string[index];
+            return in_string[index];
+        };
+        while (result.status == parse_status::error)
+        {
+            auto const nl = document.find('\n', result.consumed);
+            if (nl == Traits::sv_t::npos)
+            {
+                result.status = parse_status::need_more;
+                break;
+            }
+            auto const line = static_cast<std::uint32_t>(nl + 1);
+            if (in_string_at(active, line))
+            {
+                if (!swapped_ready)
+                {
+                    detail::find_structurals(document.data() + line, document.size() - line, indexes[1], line);
+                    swapped_ready = true;
+                }
+                active = 1 - active;
+                in_string_at(active, line);
+            }
+            result = detail::walk_structurals<Traits>(document, indexes[active], handler, scratch, cursor[active]);
+        }
+    }
+    if constexpr (detail::has_flush<Handler>::value) handler.flush();
+    return result.status;
+}
+
+}  // namespace async_json
+
+#endif
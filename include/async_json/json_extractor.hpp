@@ -10,7 +10,10 @@
 #include <async_json/basic_json_parser.hpp>
 #include <async_json/basic_is_path.hpp>
 #include <async_json/basic_on_array_element.hpp>
+#include <algorithm>
 #include <memory>
+#include <memory_resource>
+#include <string_view>
 #include <vector>
 #include <variant>
 #include <type_traits>
@@ -20,6 +23,15 @@ namespace async_json
 namespace detail
 {
 
+template <typename T, typename = void>
+struct has_skippable : std::false_type
+{
+};
+template <typename T>
+struct has_skippable<T, std::void_t<decltype(bool(std::declval<T const&>().skippable()))>> : std::true_type
+{
+};
+
 template <typename Traits, typename EH, typename... Ts>
 struct extractor
 {
@@ -37,10 +49,117 @@ struct extractor
         else
             error_handler(ev.as_error_cause());
     }
+    /// The parser skips a value when none of the paths is interested in it.
+    /// Handlers that cannot tell, like on_array_element or plain callables, disable skipping.
+    bool skip_requested() noexcept
+    {
+        if constexpr ((has_skippable<Ts>::value && ...))
+        {
+            bool skip = true;
+            tiny_tuple::foreach (data, [&skip](auto& i) { skip = skip && i.skippable(); });
+            return skip;
+        }
+        else
+            return false;
+    }
+};
+
+#if defined(ASYNC_JSON_EXTERN)
+// only the parser with a std::function handler is instantiated in the separate translation unit
+template <typename Traits, typename IT, typename Extractor>
+using extractor_parser = basic_json_parser<std::function<void(saj_event_value<Traits> const&)>, Traits, IT>;
+#else
+// the parser calls the extractor directly, so the path matching and assignments can be inlined into the event emission
+template <typename Traits, typename IT, typename Extractor>
+using extractor_parser = basic_json_parser<Extractor, Traits, IT>;
+#endif
+
+constexpr bool begins_value(saj_event ev) noexcept
+{
+    switch (ev)
+    {
+        case saj_event::object_start:
+        case saj_event::array_start:
+        case saj_event::string_value_start:
+        case saj_event::number_value_start:
+        case saj_event::integer_value:
+        case saj_event::float_value:
+        case saj_event::boolean_value:
+        case saj_event::null_value: return true;
+        default: return false;
+    }
+}
+
+constexpr bool ends_value(saj_event ev) noexcept
+{
+    switch (ev)
+    {
+        case saj_event::object_end:
+        case saj_event::array_end:
+        case saj_event::string_value_end:
+        case saj_event::number_value_end:
+        case saj_event::integer_value:
+        case saj_event::float_value:
+        case saj_event::boolean_value:
+        case saj_event::null_value: return true;
+        default: return false;
+    }
+}
+
+template <typename Event>
+constexpr std::string_view part_of(Event const& ev) noexcept
+{
+    auto const sv = ev.as_string_view();
+    return {sv.data(), sv.size()};
+}
+
+// Copies strings into mr. Parts that continue a string are appended in place while its allocation has room, otherwise
+// the allocation grows geometrically, so a string split into many parts is not copied again for every part.
+struct text_copy
+{
+    std::size_t capacity{0};  ///< of the allocation that holds the current string
+
+    std::string_view start(std::pmr::memory_resource& mr, std::string_view part)
+    {
+        capacity = part.size();
+        if (part.empty()) return {};
+        auto const data = static_cast<char*>(mr.allocate(capacity, 1));
+        std::copy(part.begin(), part.end(), data);
+        return {data, part.size()};
+    }
+    std::string_view append(std::pmr::memory_resource& mr, std::string_view text, std::string_view part)
+    {
+        auto const size = text.size() + part.size();
+        auto       data = const_cast<char*>(text.data());
+        if (size > capacity)
+        {
+            auto const grown = std::max(size, 2 * capacity);
+            auto const copy  = static_cast<char*>(mr.allocate(grown, 1));
+            std::copy(text.begin(), text.end(), copy);
+            if (capacity) mr.deallocate(data, capacity, 1);
+            data     = copy;
+            capacity = grown;
+        }
+        std::copy(part.begin(), part.end(), data + text.size());
+        return {data, size};
+    }
+};
+
+template <typename T>
+struct is_string_view_container
+{
+    constexpr static bool value = false;
+};
+template <typename A>
+struct is_string_view_container<std::vector<std::string_view, A>>
+{
+    constexpr static bool value = true;
 };
 
 }  // namespace detail
 
+/// Matches std::vector with any allocator, so std::pmr::vector targets are filled like plain vectors.
+/// Elements are constructed in place, a std::pmr::vector<std::pmr::string> passes its memory resource on to its strings.
 template <typename T>
 struct is_container
 {
@@ -151,7 +270,7 @@ constexpr auto assign_string(T& ref, std::enable_if_t<is_container<T>::value>* =
 {
     return [&ref](auto const& ev)
     {
-        if (ev.event == saj_event::string_value_start) ref.push_back(T::value_type(ev.as_string_view().begin(), ev.as_string_view().end()));
+        if (ev.event == saj_event::string_value_start) ref.emplace_back(ev.as_string_view().begin(), ev.as_string_view().end());
         if (ev.event == saj_event::string_value_cont) ref.back().append(ev.as_string_view().begin(), ev.as_string_view().end());
     };
 }
@@ -169,14 +288,57 @@ constexpr auto assign_string(F&& fun, std::enable_if_t<!is_container<std::decay_
 template <typename F>
 constexpr auto assign_string(F&& fun, std::enable_if_t<is_container<std::decay_t<decltype(fun())>>::value>* = nullptr)
 {
-    using value_type = typename std::decay_t<decltype(fun())>::value_type;
     return [fun](auto const& ev)
     {
-        if (ev.event == saj_event::string_value_start) fun().push_back(value_type(ev.as_string_view().begin(), ev.as_string_view().end()));
+        if (ev.event == saj_event::string_value_start) fun().emplace_back(ev.as_string_view().begin(), ev.as_string_view().end());
         if (ev.event == saj_event::string_value_cont) fun().back().append(ev.as_string_view().begin(), ev.as_string_view().end());
     };
 }
 
+/// Copies the string into mr and stores a view of the copy in ref, e.g. with a std::pmr::monotonic_buffer_resource that
+/// is released after each document. Further parts of a string split across input buffers are appended to the copy,
+/// which grows geometrically when it runs out of room.
+constexpr auto assign_string(std::string_view& ref, std::pmr::memory_resource& mr)
+{
+    return [&ref, &mr, text = detail::text_copy{}](auto const& ev) mutable
+    {
+        if (ev.event == saj_event::string_value_start) ref = text.start(mr, detail::part_of(ev));
+        if (ev.event == saj_event::string_value_cont) ref = text.append(mr, ref, detail::part_of(ev));
+    };
+}
+
+template <typename T>
+constexpr auto assign_string(T& ref, std::pmr::memory_resource& mr, std::enable_if_t<detail::is_string_view_container<T>::value>* = nullptr)
+{
+    return [&ref, &mr, text = detail::text_copy{}](auto const& ev) mutable
+    {
+        if (ev.event == saj_event::string_value_start) ref.push_back(text.start(mr, detail::part_of(ev)));
+        if (ev.event == saj_event::string_value_cont) ref.back() = text.append(mr, ref.back(), detail::part_of(ev));
+    };
+}
+
+template <typename F>
+constexpr auto assign_string(F&& fun, std::pmr::memory_resource& mr,
+                             std::enable_if_t<std::is_same_v<std::decay_t<decltype(fun())>, std::string_view>>* = nullptr)
+{
+    return [fun, &mr, text = detail::text_copy{}](auto const& ev) mutable
+    {
+        if (ev.event == saj_event::string_value_start) fun() = text.start(mr, detail::part_of(ev));
+        if (ev.event == saj_event::string_value_cont) fun() = text.append(mr, fun(), detail::part_of(ev));
+    };
+}
+
+template <typename F>
+constexpr auto assign_string(F&& fun, std::pmr::memory_resource& mr,
+                             std::enable_if_t<detail::is_string_view_container<std::decay_t<decltype(fun())>>::value>* = nullptr)
+{
+    return [fun, &mr, text = detail::text_copy{}](auto const& ev) mutable
+    {
+        if (ev.event == saj_event::string_value_start) fun().push_back(text.start(mr, detail::part_of(ev)));
+        if (ev.event == saj_event::string_value_cont) fun().back() = text.append(mr, fun().back(), detail::part_of(ev));
+    };
+}
+
 template <typename T>
 constexpr auto assign_name(T& ref)
 {
@@ -187,6 +349,15 @@ constexpr auto assign_name(T& ref)
     };
 }
 
+constexpr auto assign_name(std::string_view& ref, std::pmr::memory_resource& mr)
+{
+    return [&ref, &mr, text = detail::text_copy{}](auto const& ev) mutable
+    {
+        if (ev.event == saj_event::object_name_start) ref = text.start(mr, detail::part_of(ev));
+        if (ev.event == saj_event::object_name_cont) ref = text.append(mr, ref, detail::part_of(ev));
+    };
+}
+
 template <typename A, typename Traits, typename IT = table_tag>
 struct basic_path
 {
@@ -196,10 +367,11 @@ struct basic_path
     basic_path(A&& a, Ts&&... ts) : fun(a), is_path({static_cast<detail::path_element>(ts)...})
     {
     }
-    void operator()(async_json::saj_event_value<Traits> ev) noexcept
+    void operator()(async_json::saj_event_value<Traits> const& ev) noexcept
     {
         if (is_path(ev)) fun(ev);
     }
+    bool skippable() const noexcept { return is_path.skippable(); }
 };
 
 template <typename A, typename... Ts>
@@ -220,28 +392,29 @@ using fast_on_array_element = basic_on_array_element<default_traits, unrolled_ta
 template <typename EH, typename... Ts>
 constexpr auto make_extractor(EH&& eh, Ts&&... ts) noexcept
 {
-    return basic_json_parser<>(detail::extractor<default_traits, EH, Ts...>(std::forward<EH>(eh), std::forward<Ts>(ts)...));
+    using extractor_t = detail::extractor<default_traits, EH, Ts...>;
+    return detail::extractor_parser<default_traits, table_tag, extractor_t>(extractor_t(std::forward<EH>(eh), std::forward<Ts>(ts)...));
 }
 
 template <typename EH, typename... Ts>
 constexpr auto make_fast_extractor(EH&& eh, Ts&&... ts) noexcept
 {
-    return basic_json_parser<std::function<void(async_json::saj_event_value<default_traits> const&)>, default_traits, unrolled_tag>(
-        detail::extractor<default_traits, EH, Ts...>(std::forward<EH>(eh), std::forward<Ts>(ts)...));
+    using extractor_t = detail::extractor<default_traits, EH, Ts...>;
+    return detail::extractor_parser<default_traits, unrolled_tag, extractor_t>(extractor_t(std::forward<EH>(eh), std::forward<Ts>(ts)...));
 }
 
 template <typename OtherTraits, typename EH, typename... Ts>
 constexpr auto make_extractor(EH&& eh, Ts&&... ts) noexcept
 {
-    return basic_json_parser<std::function<void(async_json::saj_event_value<OtherTraits> const&)>, OtherTraits>(
-        detail::extractor<OtherTraits, EH, Ts...>(std::forward<EH>(eh), std::forward<Ts>(ts)...));
+    using extractor_t = detail::extractor<OtherTraits, EH, Ts...>;
+    return detail::extractor_parser<OtherTraits, table_tag, extractor_t>(extractor_t(std::forward<EH>(eh), std::forward<Ts>(ts)...));
 }
 
 template <typename OtherTraits, typename EH, typename... Ts>
 constexpr auto make_fast_extractor(EH&& eh, Ts&&... ts) noexcept
 {
-    return basic_json_parser<std::function<void(async_json::saj_event_value<OtherTraits> const&)>, OtherTraits, unrolled_tag>(
-        detail::extractor<OtherTraits, EH, Ts...>(std::forward<EH>(eh), std::forward<Ts>(ts)...));
+    using extractor_t = detail::extractor<OtherTraits, EH, Ts...>;
+    return detail::extractor_parser<OtherTraits, unrolled_tag, extractor_t>(extractor_t(std::forward<EH>(eh), std::forward<Ts>(ts)...));
 }
 
 }  // namespace async_json
@@ -0,0 +1,37 @@
+/* ==========================================================================
+ Copyright (c) 2024 Andreas Pokorny
+ Distributed under the Boost Software License, Version 1.0. (See accompanying
+ file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+========================================================================== */
+
+#ifndef ASYNC_JSON_NAME_HASH_HPP_INCLUDED
+#define ASYNC_JSON_NAME_HASH_HPP_INCLUDED
+
+#include <cstdint>
+#include <async_json/default_traits.hpp>
+
+namespace async_json
+{
+/// Hash of an empty name, the start value of hash_name_part.
+constexpr std::uint64_t name_hash_seed = 0xcbf29ce484222325ull;
+
+/// Continues the 64 bit FNV-1a hash h over part, so hashing the parts of a name one after the other gives the same
+/// value as hashing the whole name.
+constexpr std::uint64_t hash_name_part(std::uint64_t h, std::string_view part) noexcept
+{
+    for (char c : part)
+    {
+        h ^= static_cast<unsigned char>(c);
+        h *= 0x100000001b3ull;
+    }
+    return h;
+}
+
+/// Hash of an object name as carried by object_name_end with name_hash_traits, usable in constant expressions, e.g.
+/// as case labels. The name is hashed as reported by the parser, i.e. escape sequences are only decoded with
+/// decode_escapes_traits.
+constexpr std::uint64_t hash_name(std::string_view name) noexcept { return hash_name_part(name_hash_seed, name); }
+
+}  // namespace async_json
+
+#endif
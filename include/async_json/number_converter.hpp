@@ -0,0 +1,117 @@
+/* ==========================================================================
+ Copyright (c) 2024 Andreas Pokorny
+ Distributed under the Boost Software License, Version 1.0. (See accompanying
+ file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+========================================================================== */
+
+#ifndef ASYNC_JSON_NUMBER_CONVERTER_HPP_INCLUDED
+#define ASYNC_JSON_NUMBER_CONVERTER_HPP_INCLUDED
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <string_view>
+#include <type_traits>
+#include <async_json/detail/simd_scan.hpp>
+#include <async_json/detail/decimal_to_binary.hpp>
+
+// Converters for the number spans reported in raw number mode (see raw_number_traits).
+namespace async_json
+{
+enum class conversion_status : uint8_t
+{
+    ok,
+    out_of_range,
+    invalid
+};
+
+/// Converts a json integer to I. On failure value is left unchanged, values that do not fit into I are reported as out_of_range.
+template <typename I>
+constexpr conversion_status to_integer(std::string_view str, I& value) noexcept
+{
+    static_assert(std::is_integral_v<I>);
+    auto       it       = str.begin();
+    auto const end      = str.end();
+    bool const negative = it != end && *it == '-';
+    if (negative)
+        for (++it; it != end && detail::is_whitespace(*it);) ++it;
+    if (it == end) return conversion_status::invalid;
+
+    constexpr auto     ull_max   = std::numeric_limits<unsigned long long>::max();
+    unsigned long long magnitude = 0;
+    bool               overflow  = false;
+    for (; it != end; ++it)
+    {
+        if (!detail::is_digit(*it)) return conversion_status::invalid;
+        auto const digit = static_cast<unsigned>(*it - '0');
+        overflow |= magnitude > (ull_max - digit) / 10;
+        magnitude = magnitude * 10 + digit;
+    }
+    if (overflow) return conversion_status::out_of_range;
+
+    if (negative)
+    {
+        if constexpr (std::is_signed_v<I>)
+        {
+            constexpr auto limit = static_cast<unsigned long long>(std::numeric_limits<I>::max()) + 1;
+            if (magnitude > limit) return conversion_status::out_of_range;
+            value = magnitude == limit ? std::numeric_limits<I>::min() : static_cast<I>(-static_cast<I>(magnitude));
+        }
+        else
+        {
+            if (magnitude != 0) return conversion_status::out_of_range;
+            value = 0;
+        }
+        return conversion_status::ok;
+    }
+    if (magnitude > static_cast<unsigned long long>(std::numeric_limits<I>::max())) return conversion_status::out_of_range;
+    value = static_cast<I>(magnitude);
+    return conversion_status::ok;
+}
+
+/// Converts a json number to the nearest F. Like strtod, values beyond the range of F are stored as infinity or zero and
+/// reported as out_of_range.
+template <typename F>
+conversion_status to_float(std::string_view str, F& value)
+{
+    static_assert(std::is_floating_point_v<F>);
+    auto       it       = str.begin();
+    auto const end      = str.end();
+    bool const negative = it != end && *it == '-';
+    if (negative)
+        for (++it; it != end && detail::is_whitespace(*it);) ++it;
+
+    detail::decimal_number decimal;
+    auto const             digits_begin = it;
+    for (; it != end && detail::is_digit(*it); ++it) decimal.add_digit(static_cast<unsigned>(*it - '0'), false);
+    if (it == digits_begin) return conversion_status::invalid;
+    if (it != end && *it == '.')
+    {
+        auto const fraction_begin = ++it;
+        for (; it != end && detail::is_digit(*it); ++it) decimal.add_digit(static_cast<unsigned>(*it - '0'), true);
+        if (it == fraction_begin) return conversion_status::invalid;
+    }
+    std::int64_t exp10 = 0;
+    if (it != end && (*it == 'e' || *it == 'E'))
+    {
+        ++it;
+        bool const negative_exp = it != end && *it == '-';
+        if (it != end && (*it == '-' || *it == '+')) ++it;
+        auto const         exp_begin  = it;
+        unsigned long long exp_number = 0;
+        for (; it != end && detail::is_digit(*it); ++it)
+            exp_number = std::min(exp_number * 10 + static_cast<unsigned>(*it - '0'), detail::exponent_limit);
+        if (it == exp_begin) return conversion_status::invalid;
+        exp10 = negative_exp ? -static_cast<std::int64_t>(exp_number) : static_cast<std::int64_t>(exp_number);
+    }
+    if (it != end) return conversion_status::invalid;
+
+    value = decimal.convert<F>(negative, exp10);
+    if (value == std::numeric_limits<F>::infinity() || value == -std::numeric_limits<F>::infinity() ||
+        (value == F(0) && decimal.significand != 0))
+        return conversion_status::out_of_range;
+    return conversion_status::ok;
+}
+
+}  // namespace async_json
+
+#endif
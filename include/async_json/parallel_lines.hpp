@@ -0,0 +1,192 @@
+/* ==========================================================================
+ Copyright (c) 2024 Andreas Pokorny
+ Distributed under the Boost Software License, Version 1.0. (See accompanying
+ file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+========================================================================== */
+
+#ifndef ASYNC_JSON_PARALLEL_LINES_HPP_INCLUDED
+#define ASYNC_JSON_PARALLEL_LINES_HPP_INCLUDED
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <async_json/basic_json_parser.hpp>
+
+namespace async_json
+{
+enum class delivery
+{
+    ordered,   ///< results are passed to the consumer in input order
+    unordered  ///< results are passed to the consumer as soon as their chunk is parsed
+};
+
+struct parallel_options
+{
+    unsigned    threads{std::max(1u, std::thread::hardware_concurrency())};
+    std::size_t chunk_size{std::size_t{1} << 20};  ///< input is split at the first newline after every chunk_size bytes
+    delivery    order{delivery::ordered};
+    std::size_t window{4};  ///< maximum number of parsed but not yet delivered chunks per thread
+};
+
+namespace detail
+{
+inline std::vector<std::string_view> split_at_lines(std::string_view input, std::size_t chunk_size)
+{
+    std::vector<std::string_view> chunks;
+    chunk_size = std::max(chunk_size, std::size_t{1});
+    while (!input.empty())
+    {
+        auto end = std::min(chunk_size, input.size());
+        if (end < input.size())
+        {
+            auto const nl = static_cast<char const*>(std::memchr(input.data() + end, '\n', input.size() - end));
+            end           = nl ? static_cast<std::size_t>(nl - input.data()) + 1 : input.size();
+        }
+        chunks.push_back(input.substr(0, end));
+        input.remove_prefix(end);
+    }
+    return chunks;
+}
+
+inline bool is_blank(std::string_view line)
+{
+    return std::all_of(line.begin(), line.end(), [](char c) { return c == ' ' || c == '\t' || c == '\r' || c == '\n'; });
+}
+}  // namespace detail
+
+/// Parses every line of a JSON Lines input with one parser per worker thread.
+/// make_parser(Result& result) returns a parser, usually a make_extractor with paths or a make_struct_parser that
+/// assign into result. Every non blank line is parsed into a freshly constructed Result after a reset() of the
+/// parser, and passed to consumer(std::size_t offset, parse_status status, Result&& result) together with the byte
+/// offset of the line. The status is done for lines that parsed completely and error otherwise, the result of such a
+/// line only holds the values found before the error. The end of each line ends the input with finish(), so a line
+/// that ends within a value is reported as incomplete_input to the error handler of the parser.
+/// The consumer runs on the calling thread, the parsers and their error handlers run on the worker threads.
+/// make_parser is called on the worker threads concurrently and has to be thread safe. It is called once per worker,
+/// and again after each line that did not parse completely unless the handler of the parser has a clear() member,
+/// like make_struct_parser and make_trie_extractor, which reset() uses to drop the state of the incomplete line.
+/// The handlers of the parsers must not request suspensions.
+template <typename Result, typename MakeParser, typename Consumer>
+void parse_lines_parallel(std::string_view input, MakeParser make_parser, Consumer&& consumer, parallel_options options = {})
+{
+    using records_t   = std::vector<std::tuple<std::size_t, parse_status, Result>>;
+    auto const chunks = detail::split_at_lines(input, options.chunk_size);
+    auto const window = std::max<std::size_t>(1, options.window * std::max(1u, options.threads));
+
+    struct chunk_slot
+    {
+        records_t records;
+        bool      ready{false};
+    };
+    std::vector<chunk_slot>  slots(chunks.size());
+    std::deque<std::size_t>  completed;
+    std::mutex               mutex;
+    std::condition_variable  chunk_parsed;
+    std::condition_variable  chunk_delivered;
+    std::size_t              next_chunk{0};
+    std::size_t              delivered{0};
+    bool                     stop{false};
+
+    auto worker = [&]
+    {
+        Result                                       record;
+        std::optional<decltype(make_parser(record))> parser;
+        parser.emplace(make_parser(record));
+        for (;;)
+        {
+            std::size_t index;
+            {
+                std::unique_lock lock(mutex);
+                chunk_delivered.wait(lock, [&] { return stop || next_chunk == chunks.size() || next_chunk < delivered + window; });
+                if (stop || next_chunk == chunks.size()) return;
+                index = next_chunk++;
+            }
+            records_t   records;
+            auto        chunk  = chunks[index];
+            auto const  offset = static_cast<std::size_t>(chunk.data() - input.data());
+            std::size_t pos    = 0;
+            while (pos != chunk.size())
+            {
+                auto const nl   = chunk.find('\n', pos);
+                auto const end  = nl == std::string_view::npos ? chunk.size() : nl + 1;
+                auto const line = chunk.substr(pos, end - pos);
+                if (!detail::is_blank(line))
+                {
+                    record = Result{};
+                    parser->reset();
+                    auto status = parser->parse_some(line).status;
+                    if (status == parse_status::need_more) status = parser->finish().status;
+                    records.emplace_back(offset + pos, status, std::move(record));
+                    // handlers without clear(), like extractor paths, are not affected by reset() and rebuilt instead
+                    if constexpr (!detail::has_clear<std::remove_pointer_t<decltype(parser->callback_handler())>>::value)
+                    {
+                        if (status != parse_status::done) parser.emplace(make_parser(record));
+                    }
+                }
+                pos = end;
+            }
+            {
+                std::lock_guard lock(mutex);
+                slots[index].records = std::move(records);
+                slots[index].ready   = true;
+                if (options.order == delivery::unordered) completed.push_back(index);
+            }
+            chunk_parsed.notify_one();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    struct join_on_exit
+    {
+        std::vector<std::thread>& threads;
+        std::mutex&               mutex;
+        bool&                     stop;
+        std::condition_variable&  chunk_delivered;
+        ~join_on_exit()
+        {
+            {
+                std::lock_guard lock(mutex);
+                stop = true;
+            }
+            chunk_delivered.notify_all();
+            for (auto& t : threads) t.join();
+        }
+    } joiner{threads, mutex, stop, chunk_delivered};
+    for (unsigned i = 0, e = std::max(1u, options.threads); i != e; ++i) threads.emplace_back(worker);
+
+    while (delivered != chunks.size())
+    {
+        records_t records;
+        {
+            std::unique_lock lock(mutex);
+            if (options.order == delivery::ordered)
+            {
+                chunk_parsed.wait(lock, [&] { return slots[delivered].ready; });
+                records = std::move(slots[delivered].records);
+            }
+            else
+            {
+                chunk_parsed.wait(lock, [&] { return !completed.empty(); });
+                records = std::move(slots[completed.front()].records);
+                completed.pop_front();
+            }
+            ++delivered;
+        }
+        chunk_delivered.notify_all();
+        for (auto& [offset, status, record] : records) consumer(offset, status, std::move(record));
+    }
+}
+
+}  // namespace async_json
+
+#endif
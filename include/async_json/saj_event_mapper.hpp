@@ -27,20 +27,26 @@ constexpr hsm::event<struct object_name_end>    on_end;
 constexpr hsm::event<struct string_value_start> str_start;
 constexpr hsm::event<struct string_value_cont>  str_cont;
 constexpr hsm::event<struct string_value_end>   str_end;
+constexpr hsm::event<struct parse_error>        p_error;
+constexpr hsm::event<struct number_value_start> num_start;
+constexpr hsm::event<struct number_value_cont>  num_cont;
+constexpr hsm::event<struct number_value_end>   num_end;
+constexpr hsm::event<struct document_start>     doc_start;
+constexpr hsm::event<struct document_end>       doc_end;
 template <typename C, typename InterpreterTag, typename... Ts>
 constexpr inline auto create_saj_state_machine(Ts&&... ts) noexcept
 {
     if constexpr (std::is_same_v<InterpreterTag, table_tag>)
     {
-        return hsm::create_state_machine<C>(n_value, i_value, b_value, f_value, o_start, o_end, a_start, a_end, on_start, on_cont,
-                                                 on_end,
-
-                                                 std::forward<Ts>(ts)...);
+        return hsm::create_state_machine<C>(n_value, i_value, b_value, f_value, o_start, o_end, a_start, a_end, on_start, on_cont, on_end,
+                                            str_start, str_cont, str_end, p_error, num_start, num_cont, num_end, doc_start, doc_end,
+                                            std::forward<Ts>(ts)...);
     }
     else
     {
         return hsm::create_unrolled_sm<C>(n_value, i_value, b_value, f_value, o_start, o_end, a_start, a_end, on_start, on_cont, on_end,
-                                          str_start, str_cont, str_end, std::forward<Ts>(ts)...);
+                                          str_start, str_cont, str_end, p_error, num_start, num_cont, num_end, doc_start, doc_end,
+                                          std::forward<Ts>(ts)...);
     }
 }
 
@@ -9,7 +9,7 @@
 
 #include <type_traits>
 #include <algorithm>
-#include <variant>
+#include <cstdint>
 #include <async_json/default_traits.hpp>  // error cause
 
 namespace async_json
@@ -21,12 +21,13 @@ struct void_t
 enum class saj_variant_value : uint8_t
 {
     none         = 0,
-    number       = 1 << 4,
-    float_number = 2 << 4,
-    boolean      = 3 << 4,
-    string       = 4 << 4,
-    error        = 5 << 4,
-    mask         = 0xF0
+    number       = 1 << 5,
+    float_number = 2 << 5,
+    boolean      = 3 << 5,
+    string       = 4 << 5,
+    error        = 5 << 5,
+    raw_number   = 6 << 5,
+    mask         = 0xE0
 };
 
 template <typename E>
@@ -50,7 +51,12 @@ enum class saj_event : uint8_t
     string_value_start = 12 + cast(saj_variant_value::string),
     string_value_cont  = 13 + cast(saj_variant_value::string),
     string_value_end   = 14 + cast(saj_variant_value::none),
-    parse_error        = 15 + cast(saj_variant_value::error)
+    parse_error        = 15 + cast(saj_variant_value::error),
+    number_value_start = 16 + cast(saj_variant_value::raw_number),
+    number_value_cont  = 17 + cast(saj_variant_value::raw_number),
+    number_value_end   = 18 + cast(saj_variant_value::none),
+    document_start     = 19 + cast(saj_variant_value::none),
+    document_end       = 20 + cast(saj_variant_value::none)
 };
 
 template <typename Traits>
@@ -59,9 +65,29 @@ struct saj_event_value
     using sv_t      = typename Traits::sv_t;
     using integer_t = typename Traits::integer_t;
     using float_t   = typename Traits::float_t;
+    static_assert(std::is_trivially_copyable_v<sv_t> && std::is_trivially_copyable_v<integer_t> && std::is_trivially_copyable_v<float_t>,
+                  "saj_event_value expects trivially copyable value types");
 
-    saj_event event{saj_event::null_value};
-    std::variant<sv_t, bool, float_t, integer_t, error_cause> store;
+    // the active member is selected by the saj_variant_value bits of event
+    union value_store
+    {
+        integer_t     number;
+        float_t       float_number;
+        bool          boolean;
+        error_cause   error;
+        sv_t          string;
+        std::uint64_t name_hash;  ///< of object_name_end with name_hash_traits
+
+        constexpr value_store() noexcept : number{0} {}
+        constexpr value_store(integer_t i) noexcept : number{i} {}
+        constexpr value_store(float_t f) noexcept : float_number{f} {}
+        constexpr value_store(bool b) noexcept : boolean{b} {}
+        constexpr value_store(error_cause e) noexcept : error{e} {}
+        constexpr value_store(sv_t s) noexcept : string{s} {}
+    };
+
+    value_store store;
+    saj_event   event{saj_event::null_value};
 
     constexpr saj_event_value()                        = default;
     constexpr saj_event_value(saj_event_value const &) = default;
@@ -69,17 +95,26 @@ struct saj_event_value
     constexpr saj_event_value &operator=(saj_event_value const &) = default;
     constexpr saj_event_value &operator=(saj_event_value &&) = default;
     constexpr explicit saj_event_value(saj_event ev) : event{ev} {}
-    constexpr saj_event_value(saj_event ev, float_t f) : event{ev}, store(f) {}
-    constexpr saj_event_value(saj_event ev, integer_t i) : event{ev}, store(i) {}
-    constexpr saj_event_value(saj_event ev, bool b) : event{ev}, store(b) {}
-    constexpr saj_event_value(saj_event ev, error_cause e) : event{ev}, store(e) {}
-    constexpr saj_event_value(saj_event ev, sv_t s) : event{ev}, store(s) {}
+    constexpr saj_event_value(saj_event ev, float_t f) : store(f), event{ev} {}
+    constexpr saj_event_value(saj_event ev, integer_t i) : store(i), event{ev} {}
+    constexpr saj_event_value(saj_event ev, bool b) : store(b), event{ev} {}
+    constexpr saj_event_value(saj_event ev, error_cause e) : store(e), event{ev} {}
+    constexpr saj_event_value(saj_event ev, sv_t s) : store(s), event{ev} {}
 
-    constexpr auto as_number() const noexcept { return std::get<integer_t>(store); }
-    constexpr auto as_float_number() const noexcept { return std::get<float_t>(store); }
-    constexpr auto as_string_view() const noexcept { return std::get<sv_t>(store); }
-    constexpr auto as_bool() const noexcept { return std::get<bool>(store); }
-    constexpr auto as_error_cause() const noexcept { return std::get<error_cause>(store); }
+    /// object_name_end carrying the hash of the name, only emitted with name_hash_traits
+    static constexpr saj_event_value name_end(std::uint64_t hash) noexcept
+    {
+        saj_event_value ev(saj_event::object_name_end);
+        ev.store.name_hash = hash;
+        return ev;
+    }
+
+    constexpr auto as_number() const noexcept { return store.number; }
+    constexpr auto as_float_number() const noexcept { return store.float_number; }
+    constexpr auto as_string_view() const noexcept { return store.string; }
+    constexpr auto as_bool() const noexcept { return store.boolean; }
+    constexpr auto as_error_cause() const noexcept { return store.error; }
+    constexpr auto as_name_hash() const noexcept { return store.name_hash; }
     constexpr bool is_value() const noexcept
     {
         switch (event)
@@ -90,7 +125,10 @@ struct saj_event_value
             case saj_event::float_value:
             case saj_event::string_value_start:
             case saj_event::string_value_cont:
-            case saj_event::string_value_end: return true;
+            case saj_event::string_value_end:
+            case saj_event::number_value_start:
+            case saj_event::number_value_cont:
+            case saj_event::number_value_end: return true;
             default: return false;
         }
     }
@@ -99,8 +137,11 @@ struct saj_event_value
     {
         return static_cast<saj_variant_value>(cast(event) & cast(saj_variant_value::mask));
     }
-    constexpr auto as_event_id() const noexcept { return cast(event) & 0xF; }
+    constexpr auto as_event_id() const noexcept { return cast(event) & 0x1F; }
 };
 
+static_assert(std::is_trivially_copyable_v<saj_event_value<default_traits>>);
+static_assert(sizeof(saj_event_value<default_traits>) <= 24);
+
 }  // namespace async_json
 #endif
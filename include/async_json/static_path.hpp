@@ -0,0 +1,214 @@
+/* ==========================================================================
+ Copyright (c) 2024 Andreas Pokorny
+ Distributed under the Boost Software License, Version 1.0. (See accompanying
+ file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+========================================================================== */
+
+#ifndef ASYNC_JSON_STATIC_PATH_HPP_INCLUDED
+#define ASYNC_JSON_STATIC_PATH_HPP_INCLUDED
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <async_json/json_extractor.hpp>
+#include <async_json/name_hash.hpp>
+
+// requires C++20 for string literals as template arguments
+namespace async_json
+{
+/// String literal usable as template argument, e.g. static_path<"result", "items">(...).
+template <std::size_t N>
+struct fixed_string
+{
+    char value[N]{};
+    constexpr fixed_string(char const (&str)[N]) noexcept
+    {
+        for (std::size_t i = 0; i != N; ++i) value[i] = str[i];
+    }
+    constexpr std::size_t      size() const noexcept { return N - 1; }
+    constexpr std::string_view view() const noexcept { return {value, N - 1}; }
+};
+
+/// Path with the object names fixed at compile time, used like basic_path within an extractor.
+/// The matcher state has a fixed size and every name is only compared with the constant element of the current
+/// nesting level: parts that do not fit into that element are rejected by their length, the remaining ones by a compare
+/// of constant size. With name_hash_traits the parts are ignored and the hash on object_name_end is compared instead.
+/// Arrays are transparent like with basic_path, arbitrary elements are not supported.
+template <typename Traits, typename A, fixed_string... Names>
+struct basic_static_path
+{
+    using event_value                  = saj_event_value<Traits>;
+    static constexpr std::size_t depth = sizeof...(Names);
+    static constexpr std::array<std::string_view, depth> names{Names.view()...};
+    static constexpr std::array<std::uint64_t, depth>    hashes{hash_name(Names.view())...};
+    static constexpr bool                                by_hash = detail::has_name_hashes<Traits>::value;
+
+    A fun;
+
+    constexpr explicit basic_static_path(A&& a) : fun(std::forward<A>(a)) {}
+
+    void operator()(event_value const& ev)
+    {
+        // a value that is delivered or skipped when the document ends with an error is not continued in the next one
+        if (ev.event == saj_event::document_start || ev.event == saj_event::parse_error)
+        {
+            reset();
+            return;
+        }
+        if (delivering)
+        {
+            fun(ev);
+            if (ev.event == saj_event::object_start || ev.event == saj_event::array_start)
+                ++value_depth;
+            else if (ev.event == saj_event::object_end || ev.event == saj_event::array_end)
+                --value_depth;
+            if (value_depth == 0 && detail::ends_value(ev.event)) delivering = false;
+            return;
+        }
+        if (dead)
+        {
+            if (ev.event == saj_event::object_start || ev.event == saj_event::array_start)
+                ++dead;
+            else if (ev.event == saj_event::object_end || ev.event == saj_event::array_end)
+                --dead;
+            return;
+        }
+        off_value = false;
+        switch (ev.event)
+        {
+            case saj_event::object_name_start:
+                if constexpr (by_hash) return;
+                name_pos = 0;
+                name_ok  = true;
+                [[fallthrough]];
+            case saj_event::object_name_cont:
+            {
+                if constexpr (by_hash) return;
+                auto const sv = ev.as_string_view();
+                name_ok       = name_ok && match_part(std::string_view(sv.data(), sv.size()), std::make_index_sequence<depth>{});
+                return;
+            }
+            case saj_event::object_name_end:
+                if constexpr (by_hash)
+                    name_matched = level < depth && ev.as_name_hash() == hashes[level];
+                else
+                    name_matched = name_ok && name_pos == name_size(std::make_index_sequence<depth>{});
+                off_value    = !name_matched;
+                return;
+            case saj_event::object_end:
+            case saj_event::array_end: close(); return;
+            default: break;
+        }
+        if (!detail::begins_value(ev.event)) return;
+
+        std::size_t next    = 0;
+        bool const  matched = std::exchange(name_matched, false);
+        if (objects[level])
+        {
+            if (!matched)
+            {
+                if (ev.event == saj_event::object_start || ev.event == saj_event::array_start) dead = 1;
+                return;
+            }
+            next = level + 1;
+        }
+        else if (arrays[level])
+            next = level;
+        if (next == depth)
+        {
+            delivering  = true;
+            value_depth = 0;
+            (*this)(ev);
+            return;
+        }
+        if (ev.event == saj_event::object_start)
+        {
+            level          = next;
+            objects[level] = true;
+        }
+        else if (ev.event == saj_event::array_start)
+        {
+            level = next;
+            ++arrays[level];
+        }
+    }
+
+    /// true when the next value cannot contain a match, see has_skippable
+    bool skippable() const noexcept { return off_value || dead != 0; }
+
+    void reset() noexcept
+    {
+        objects      = {};
+        arrays       = {};
+        level        = 0;
+        dead         = 0;
+        value_depth  = 0;
+        delivering   = false;
+        name_matched = false;
+        off_value    = false;
+    }
+
+   private:
+    template <std::size_t I>
+    bool match_part_at(std::string_view part) noexcept
+    {
+        constexpr auto name = names[I];
+        if (part.size() > name.size() - name_pos) return false;
+        if (std::char_traits<char>::compare(name.data() + name_pos, part.data(), part.size()) != 0) return false;
+        name_pos += part.size();
+        return true;
+    }
+    template <std::size_t... Is>
+    bool match_part(std::string_view part, std::index_sequence<Is...>) noexcept
+    {
+        return ((level == Is && match_part_at<Is>(part)) || ...);
+    }
+    template <std::size_t... Is>
+    std::size_t name_size(std::index_sequence<Is...>) const noexcept
+    {
+        std::size_t size = 0;
+        ((level == Is ? void(size = names[Is].size()) : void()), ...);
+        return size;
+    }
+
+    void close() noexcept
+    {
+        if (objects[level])
+            objects[level] = false;
+        else if (arrays[level])
+            --arrays[level];
+        // back in the object that holds the array or object of this level
+        if (level && !objects[level] && !arrays[level]) --level;
+    }
+
+    // per matched level: whether its object is open and how many arrays around it are open
+    std::array<bool, depth + 1>          objects{};
+    std::array<std::uint32_t, depth + 1> arrays{};
+    std::size_t                          level{0};
+    std::size_t                          name_pos{0};
+    std::uint32_t                        dead{0};
+    std::uint32_t                        value_depth{0};
+    bool                                 delivering{false};
+    bool                                 name_ok{false};
+    bool                                 name_matched{false};
+    bool                                 off_value{false};
+};
+
+template <fixed_string... Names, typename A>
+constexpr auto static_path(A&& a)
+{
+    return basic_static_path<default_traits, std::decay_t<A>, Names...>(std::decay_t<A>(std::forward<A>(a)));
+}
+
+template <typename Traits, fixed_string... Names, typename A>
+constexpr auto static_path(A&& a)
+{
+    return basic_static_path<Traits, std::decay_t<A>, Names...>(std::decay_t<A>(std::forward<A>(a)));
+}
+
+}  // namespace async_json
+
+#endif
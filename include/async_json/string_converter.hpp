@@ -6,8 +6,12 @@
 
 #ifndef ASYNC_JSON_STRING_CONVERSION_HPP_INCLUDED
 #define ASYNC_JSON_STRING_CONVERSION_HPP_INCLUDED
+#include <cstdint>
+#include <cstring>
 #include <string>
-#include <array>
+#include <string_view>
+#include <utility>
+#include <async_json/detail/simd_scan.hpp>
 namespace async_json
 {
 namespace detail
@@ -15,148 +19,127 @@ namespace detail
 inline bool         is_hex(char c) noexcept { return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F'); }
 inline unsigned int from_hex(char c) noexcept
 {
-    return static_cast<unsigned int>(c - ((c >= '0' && c <= '9') ? '0' : (c >= 'a' && c <= 'f') ? 'a' : 'A'));
+    return static_cast<unsigned int>(c - ((c >= '0' && c <= '9') ? '0' : (c >= 'a' && c <= 'f') ? 'a' - 10 : 'A' - 10));
 }
-}  // namespace detail
-inline std::string& json_to_utf8(std::string& str)
+
+// reads the four hex digits of a \u escape sequence at p
+inline bool read_hex4(char const* p, unsigned int& cp) noexcept
 {
-    enum escape_state
+    cp = 0;
+    for (int i = 0; i != 4; ++i)
     {
-        none,
-        bs,
-        uhex1,
-        uhex2,
-        uhex3,
-        uhex4,
-        hex_done
-    };
-    escape_state                es{none};
-    std::array<unsigned int, 4> factors{{12u, 8u, 4u, 0u}};
-    int                         codepoint         = 0;
-    std::size_t                 multiplier        = 0;
-    auto                        consume_codepoint = [&str, &multiplier, &factors, &es](int& cp, size_t i) -> bool
+        if (!is_hex(p[i])) return false;
+        cp = (cp << 4u) | from_hex(p[i]);
+    }
+    return true;
+}
+
+inline char* encode_utf8(unsigned int cp, char* out) noexcept
+{
+    if (cp < 0x80)
+        *out++ = static_cast<char>(cp);
+    else if (cp < 0x800)
     {
-        if (detail::is_hex(str[i]))
-        {
-            cp += static_cast<int>(detail::from_hex(str[i]) << factors.at(multiplier++));
-            es = static_cast<decltype(es)>(static_cast<int>(es) + 1);
-            return true;
-        }
-        else { return false; }
+        *out++ = static_cast<char>(0xC0u | (cp >> 6u));
+        *out++ = static_cast<char>(0x80u | (cp & 0x3Fu));
+    }
+    else if (cp < 0x10000)
+    {
+        *out++ = static_cast<char>(0xE0u | (cp >> 12u));
+        *out++ = static_cast<char>(0x80u | ((cp >> 6u) & 0x3Fu));
+        *out++ = static_cast<char>(0x80u | (cp & 0x3Fu));
+    }
+    else
+    {
+        *out++ = static_cast<char>(0xF0u | (cp >> 18u));
+        *out++ = static_cast<char>(0x80u | ((cp >> 12u) & 0x3Fu));
+        *out++ = static_cast<char>(0x80u | ((cp >> 6u) & 0x3Fu));
+        *out++ = static_cast<char>(0x80u | (cp & 0x3Fu));
+    }
+    return out;
+}
+}  // namespace detail
+
+enum class decode_status : uint8_t
+{
+    ok,
+    invalid_escape,      ///< unknown character after '\\' or a '\\' at the end
+    invalid_unicode,     ///< \u not followed by four hex digits
+    unpaired_surrogate,  ///< high surrogate without a following low surrogate or a single low surrogate
+};
+
+struct decode_result
+{
+    decode_status status;
+    std::size_t   read;     ///< bytes of the input decoded, on error the offset of the invalid escape sequence
+    std::size_t   written;  ///< bytes written to the output
+};
+
+/// Replaces the escape sequences of a json string body in one pass and writes the result to out.
+/// out has to provide str.size() bytes, the output is never longer than the input. out may also be str.data() to decode
+/// in place. Backslashes are searched with block wise SIMD compares and the runs between them are copied in bulk.
+inline decode_result json_to_utf8(std::string_view str, char* out) noexcept
+{
+    auto       first = str.data();
+    auto const last  = first + str.size();
+    auto const begin = out;
+    auto const fail  = [&](decode_status status, char const* at)
+    {
+        return decode_result{status, static_cast<std::size_t>(at - str.data()), static_cast<std::size_t>(out - begin)};
     };
-    for (size_t i = 0; i != str.size(); ++i)
+    while (first != last)
     {
-        switch (es)
+        auto const esc = detail::find_escape(first, last);
+        auto const run = static_cast<std::size_t>(esc - first);
+        if (out != first) std::memmove(out, first, run);
+        out += run;
+        if (esc == last) break;
+        if (last - esc < 2) return fail(decode_status::invalid_escape, esc);
+        first = esc + 2;
+        switch (esc[1])
         {
-            case none:
-                if (str[i] == '\\') es = bs;
-                break;
-            case bs:
+            case '"': *out++ = '"'; break;
+            case '\\': *out++ = '\\'; break;
+            case '/': *out++ = '/'; break;
+            case 'b': *out++ = '\b'; break;
+            case 'f': *out++ = '\f'; break;
+            case 'n': *out++ = '\n'; break;
+            case 'r': *out++ = '\r'; break;
+            case 't': *out++ = '\t'; break;
+            case 'u':
             {
-                char const* rep = nullptr;
-                switch (str[i])
+                unsigned int cp;
+                if (last - first < 4 || !detail::read_hex4(first, cp)) return fail(decode_status::invalid_unicode, esc);
+                first += 4;
+                if (0xDC00 <= cp && cp <= 0xDFFF) return fail(decode_status::unpaired_surrogate, esc);
+                if (0xD800 <= cp && cp <= 0xDBFF)
                 {
-                    case '\\': rep = "\\"; break;
-                    case 'b': rep = "\b"; break;
-                    case 't': rep = "\t"; break;
-                    case 'r': rep = "\r"; break;
-                    case 'n': rep = "\n"; break;
-                    case '"': rep = "\""; break;
-                    case 'u':
-                        if (str.size() - i < 4) return str;  // with error
-                        es         = uhex1;
-                        multiplier = 0;
-                        codepoint  = 0;
-                        continue;
-                    default: return str;  // with error;
-                }
-                if (rep)
-                {
-                    str.replace(--i, 2, rep);
-                    es = none;
+                    // the low surrogate has to follow as another \u escape sequence
+                    unsigned int low;
+                    if (last - first < 6 || first[0] != '\\' || first[1] != 'u' || !detail::read_hex4(first + 2, low) || low < 0xDC00 ||
+                        low > 0xDFFF)
+                        return fail(decode_status::unpaired_surrogate, esc);
+                    first += 6;
+                    cp = 0x10000 + ((cp - 0xD800) << 10u) + (low - 0xDC00);
                 }
+                out = detail::encode_utf8(cp, out);
                 break;
             }
-            case uhex1:
-            case uhex2:
-            case uhex3:
-            case uhex4:
-                if (!consume_codepoint(codepoint, i)) return str;  // error
-                if (es == hex_done)
-                {
-                    size_t chars_to_replace = 6;
-                    // two consecutive codepoints:
-                    if (0xD800 <= codepoint && codepoint <= 0xDBFF)
-                    {
-                        chars_to_replace += 6;
-                        int cp2 = 0;
-                        es      = uhex1;
-                        multiplier = 0;
-                        if (i + 6 < str.size() && str[i + 1] == '\\' && str[i + 2] == 'u' && consume_codepoint(cp2, i + 3) &&
-                            consume_codepoint(cp2, i + 4) && consume_codepoint(cp2, i + 5) && consume_codepoint(cp2, i + 6))
-                        {
-                            if (0xDC00 <= cp2 && cp2 <= 0xDFFF)
-                                // overwrite codepoint
-                                codepoint = static_cast<int>(
-                                    // high surrogate occupies the most significant 22 bits
-                                    (static_cast<unsigned int>(codepoint) << 10u)
-                                    // low surrogate occupies the least significant 15 bits
-                                    + static_cast<unsigned int>(cp2)
-                                    // there is still the 0xD800, 0xDC00 and 0x10000 noise
-                                    // in the result so we have to subtract with:
-                                    // (0xD800 << 10) + DC00 - 0x10000 = 0x35FDC00
-                                    - 0x35FDC00u);
-                            else
-                                return str;  // error
-                        }
-                        else
-                        {
-                            return str;  // error
-                        }
-                    }
-                    else if (0xDC00 <= codepoint && codepoint <= 0xDFFF)
-                        return str;  // error
-                    std::array<char,5> array{{0, 0, 0, 0, 0}};
-                    auto replacement_pos = i - 5;
-                    if (codepoint < 0x80)
-                    {
-                        array[0] = static_cast<char>(codepoint);
-                        str.replace(replacement_pos, chars_to_replace, array.data());
-                        i -= 6;
-                    }
-                    else if (codepoint <= 0x7FF)
-                    {
-                        array[0] = static_cast<char>(0xC0u | (static_cast<unsigned int>(codepoint) >> 6u));
-                        array[1] = static_cast<char>(0x80u | (static_cast<unsigned int>(codepoint) & 0x3Fu));
-                        str.replace(replacement_pos, chars_to_replace, array.data());
-                        i -= 5;
-                    }
-                    else if (codepoint <= 0xFFFF)
-                    {
-                        // 3-byte characters: 1110xxxx 10xxxxxx 10xxxxxx
-                        array[0] = static_cast<char>(0xE0u | (static_cast<unsigned int>(codepoint) >> 12u));
-                        array[1] = static_cast<char>(0x80u | ((static_cast<unsigned int>(codepoint) >> 6u) & 0x3Fu));
-                        array[2] = static_cast<char>(0x80u | (static_cast<unsigned int>(codepoint) & 0x3Fu));
-                        str.replace(replacement_pos, chars_to_replace, array.data());
-                        i -= 4;
-                    }
-                    else
-                    {
-                        // 4-byte characters: 11110xxx 10xxxxxx 10xxxxxx 10xxxxxx
-                        array[0] = static_cast<char>(0xF0u | (static_cast<unsigned int>(codepoint) >> 18u));
-                        array[1] = static_cast<char>(0x80u | ((static_cast<unsigned int>(codepoint) >> 12u) & 0x3Fu));
-                        array[2] = static_cast<char>(0x80u | ((static_cast<unsigned int>(codepoint) >> 6u) & 0x3Fu));
-                        array[3] = static_cast<char>(0x80u | (static_cast<unsigned int>(codepoint) & 0x3Fu));
-                        str.replace(replacement_pos, chars_to_replace, array.data());
-                        i -= 3;
-                    }
-                    es = none;
-                }
-                break;
-            case hex_done:
-            default: break;
+            default: return fail(decode_status::invalid_escape, esc);
         }
     }
+    return {decode_status::ok, str.size(), static_cast<std::size_t>(out - begin)};
+}
+
+/// Replaces the escape sequences in str. When an invalid escape sequence is found the rest of str is left unchanged,
+/// use json_to_utf8(str, out) to get the error.
+inline std::string& json_to_utf8(std::string& str)
+{
+    auto const ret = json_to_utf8(std::string_view(str), str.data());
+    if (ret.status == decode_status::ok)
+        str.resize(ret.written);
+    else
+        str.erase(ret.written, ret.read - ret.written);
     return str;
 }
 
@@ -0,0 +1,404 @@
+/* ==========================================================================
+ Copyright (c) 2024 Andreas Pokorny
+ Distributed under the Boost Software License, Version 1.0. (See accompanying
+ file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+========================================================================== */
+
+#ifndef ASYNC_JSON_STRUCT_BINDING_HPP_INCLUDED
+#define ASYNC_JSON_STRUCT_BINDING_HPP_INCLUDED
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <async_json/json_extractor.hpp>
+#include <async_json/name_hash.hpp>
+#include <async_json/number_converter.hpp>
+
+namespace async_json
+{
+/// Json name of a member of T.
+template <typename T, typename M>
+struct field_binding
+{
+    std::string_view name;
+    M T::*           member;
+};
+
+template <typename T, typename M>
+constexpr field_binding<T, M> field(std::string_view name, M T::*member) noexcept
+{
+    return {name, member};
+}
+
+template <typename... Fs>
+constexpr auto fields(Fs... fs) noexcept
+{
+    return std::tuple<Fs...>(fs...);
+}
+
+/// Specialize with a static constexpr member fields to bind the members of T to object names, e.g.
+/// template <> struct async_json::binding<point> { static constexpr auto fields = async_json::fields(field("x", &point::x)); };
+/// Members can be numbers, bool, strings, bound structs and std::vectors of those.
+template <typename T>
+struct binding;
+
+namespace detail
+{
+// Stores value in member if M can represent it, otherwise member is left unchanged. Floats are truncated towards zero
+// into integers, casting a float beyond the range of M would be undefined behaviour.
+template <typename M, typename V>
+bool assign_in_range(M& member, V value) noexcept
+{
+    using limits = std::numeric_limits<M>;
+    if constexpr (std::is_same_v<M, bool> || std::is_same_v<V, bool>)
+    {
+        // every value converts to bool and a bool to every M
+    }
+    else if constexpr (std::is_integral_v<M> && std::is_integral_v<V>)
+    {
+        if constexpr (std::is_signed_v<V>)
+        {
+            if (value < 0 && (std::is_unsigned_v<M> || static_cast<std::intmax_t>(value) < static_cast<std::intmax_t>(limits::min())))
+                return false;
+        }
+        if (value > 0 && static_cast<std::uintmax_t>(value) > static_cast<std::uintmax_t>(limits::max())) return false;
+    }
+    else if constexpr (std::is_integral_v<M>)
+    {
+        auto const whole = std::trunc(value);
+        if (!(whole >= static_cast<V>(limits::min()) && whole < std::ldexp(V{1}, limits::digits))) return false;
+    }
+    else if constexpr (std::is_floating_point_v<V>)
+    {
+        if (std::isfinite(value) && std::fabs(value) > static_cast<V>(limits::max())) return false;
+    }
+    member = static_cast<M>(value);
+    return true;
+}
+
+template <typename T, typename = void>
+struct is_bound : std::false_type
+{
+};
+template <typename T>
+struct is_bound<T, std::void_t<decltype(binding<T>::fields)>> : std::true_type
+{
+};
+
+template <typename T, typename = void>
+struct is_text : std::false_type
+{
+};
+template <typename T>
+struct is_text<T, std::void_t<decltype(std::declval<T&>().append(std::declval<char const*>(), std::size_t{}))>> : std::true_type
+{
+};
+
+template <typename T, std::size_t... Is>
+constexpr auto field_names(std::index_sequence<Is...>) noexcept
+{
+    return std::array<std::string_view, sizeof...(Is)>{{std::get<Is>(binding<T>::fields).name...}};
+}
+
+/// Open addressing table from name hashes to field indices of T, built at compile time.
+/// Most names are found with a single probe, independent of the number of fields, the name of a hit is compared to
+/// rule out names that only share the hash of a field.
+template <typename T>
+struct field_table
+{
+    static constexpr std::uint32_t no_field = ~std::uint32_t{0};
+    static constexpr std::size_t   count    = std::tuple_size_v<std::decay_t<decltype(binding<T>::fields)>>;
+    static constexpr std::size_t   size     = []
+    {
+        std::size_t s = 2;
+        while (s < 2 * count) s *= 2;
+        return s;
+    }();
+
+    static constexpr auto names  = field_names<T>(std::make_index_sequence<count>{});
+    static constexpr auto hashes = []
+    {
+        std::array<std::uint64_t, count> ret{};
+        for (std::size_t i = 0; i != count; ++i) ret[i] = hash_name(names[i]);
+        return ret;
+    }();
+    static_assert(
+        []
+        {
+            for (std::size_t i = 0; i != count; ++i)
+                for (std::size_t j = i + 1; j != count; ++j)
+                    if (hashes[i] == hashes[j]) return false;
+            return true;
+        }(),
+        "the names of the fields of a binding have to be unique and must not share a hash");
+
+    // field index + 1 per slot, 0 for empty slots
+    static constexpr auto slots = []
+    {
+        std::array<std::uint32_t, size> ret{};
+        for (std::uint32_t i = 0; i != count; ++i)
+        {
+            auto s = hashes[i] & (size - 1);
+            while (ret[s]) s = (s + 1) & (size - 1);
+            ret[s] = i + 1;
+        }
+        return ret;
+    }();
+
+    static constexpr std::uint32_t find(std::uint64_t hash, std::string_view name) noexcept
+    {
+        for (auto s = hash & (size - 1);; s = (s + 1) & (size - 1))
+        {
+            auto const i = slots[s];
+            if (i == 0) return no_field;
+            if (hashes[i - 1] == hash) return names[i - 1] == name ? i - 1 : no_field;
+        }
+    }
+};
+
+template <typename Binder>
+struct level_ops
+{
+    using ev_t = typename Binder::ev_t;
+    std::uint32_t (*find)(std::uint64_t hash, std::string_view name) noexcept;  ///< nullptr for arrays
+    void (*begin)(Binder& b, void* object, std::uint32_t field, ev_t const& ev);
+};
+
+template <typename Binder, typename T, std::size_t... Is>
+constexpr auto make_field_dispatch(std::index_sequence<Is...>) noexcept
+{
+    using ev_t = typename Binder::ev_t;
+    return std::array<void (*)(Binder&, T&, ev_t const&), sizeof...(Is)>{
+        {[](Binder& b, T& object, ev_t const& ev) { b.begin_value(object.*(std::get<Is>(binding<T>::fields).member), ev); }...}};
+}
+
+template <typename Binder, typename T>
+struct struct_level
+{
+    using ev_t                     = typename Binder::ev_t;
+    static constexpr auto dispatch = make_field_dispatch<Binder, T>(std::make_index_sequence<field_table<T>::count>{});
+
+    static void begin(Binder& b, void* object, std::uint32_t field, ev_t const& ev)
+    {
+        if (field == field_table<T>::no_field) return b.ignore(ev);
+        dispatch[field](b, *static_cast<T*>(object), ev);
+    }
+    static constexpr level_ops<Binder> ops{&field_table<T>::find, &begin};
+};
+
+template <typename Binder, typename V>
+struct array_level
+{
+    using ev_t = typename Binder::ev_t;
+    using E    = typename V::value_type;
+
+    static void begin(Binder& b, void* object, std::uint32_t, ev_t const& ev)
+    {
+        auto& elements = *static_cast<V*>(object);
+        if (!Binder::template accepts<E>(ev)) return b.ignore(ev);
+        if constexpr (std::is_arithmetic_v<E>)
+        {
+            if (ev.event != saj_event::number_value_start)
+            {
+                Binder::assign_scalar(elements.emplace_back(), ev);
+                return;
+            }
+        }
+        elements.emplace_back();
+        b.begin_value(elements.back(), ev);
+    }
+    static constexpr level_ops<Binder> ops{nullptr, &begin};
+};
+
+// Writes the values of a json object into the members of T. Every nesting level is a bound struct or a vector, names
+// are looked up in the field_table of the struct, so the cost per event does not depend on the number of fields.
+// With raw_numbers the span of a number is collected and converted with to_integer or to_float at number_value_end.
+template <typename Traits, typename T, typename EH>
+struct struct_binder
+{
+    using ev_t                              = saj_event_value<Traits>;
+    static constexpr std::uint32_t no_field = ~std::uint32_t{0};
+    struct frame
+    {
+        void*                           object;
+        level_ops<struct_binder> const* ops;
+    };
+
+    T&                 target;
+    EH                 error_handler;
+    std::vector<frame> frames;
+    std::uint64_t      name_hash{name_hash_seed};
+    std::string        name;  ///< parts of the current name, the view of a part may end with its input buffer
+    std::uint32_t      field{no_field};
+    std::uint32_t      ignored{0};  ///< depth within a value without a member
+    void*              text{nullptr};
+    void (*append)(void*, std::string_view){nullptr};
+    void*              number{nullptr};
+    std::string        number_span;
+    void (*assign_number)(void*, std::string_view){nullptr};
+
+    struct_binder(T& t, EH&& eh) : target(t), error_handler(std::forward<EH>(eh)) {}
+
+    void operator()(ev_t const& ev)
+    {
+        if (ev.event == saj_event::parse_error)
+        {
+            clear();
+            error_handler(ev.as_error_cause());
+            return;
+        }
+        if (ignored)
+        {
+            if (ev.event == saj_event::object_start || ev.event == saj_event::array_start)
+                ++ignored;
+            else if (ev.event == saj_event::object_end || ev.event == saj_event::array_end)
+                --ignored;
+            return;
+        }
+        switch (ev.event)
+        {
+            case saj_event::object_name_start:
+                if constexpr (!has_name_hashes<Traits>::value) name_hash = hash_name_part(name_hash_seed, part_of(ev));
+                name = part_of(ev);
+                return;
+            case saj_event::object_name_cont:
+                if constexpr (!has_name_hashes<Traits>::value) name_hash = hash_name_part(name_hash, part_of(ev));
+                name += part_of(ev);
+                return;
+            case saj_event::object_name_end:
+                if constexpr (has_name_hashes<Traits>::value) name_hash = ev.as_name_hash();
+                field = frames.back().ops->find(name_hash, name);
+                return;
+            case saj_event::string_value_cont:
+                if (text) append(text, part_of(ev));
+                return;
+            case saj_event::string_value_end: text = nullptr; return;
+            case saj_event::number_value_cont:
+                if (number) number_span += part_of(ev);
+                return;
+            case saj_event::number_value_end:
+                if (number) assign_number(number, number_span);
+                number = nullptr;
+                return;
+            case saj_event::object_end:
+            case saj_event::array_end: frames.pop_back(); return;
+            default: break;
+        }
+        if (!begins_value(ev.event)) return;
+        if (frames.empty())
+            begin_value(target, ev);
+        else
+            frames.back().ops->begin(*this, frames.back().object, std::exchange(field, no_field), ev);
+    }
+
+    /// Values of names without a member are skipped by the parser.
+    bool skip_requested() const noexcept { return !ignored && !frames.empty() && frames.back().ops->find && field == no_field; }
+
+    void clear() noexcept
+    {
+        frames.clear();
+        field   = no_field;
+        ignored = 0;
+        text    = nullptr;
+        number  = nullptr;
+    }
+
+    template <typename M>
+    static constexpr bool accepts(ev_t const& ev) noexcept
+    {
+        if constexpr (is_bound<M>::value)
+            return ev.event == saj_event::object_start;
+        else if constexpr (is_container<M>::value)
+            return ev.event == saj_event::array_start;
+        else if constexpr (is_text<M>::value)
+            return ev.event == saj_event::string_value_start;
+        else
+            return ev.event == saj_event::integer_value || ev.event == saj_event::float_value || ev.event == saj_event::boolean_value ||
+                   ev.event == saj_event::number_value_start;
+    }
+
+    // values that M cannot represent leave member unchanged
+    template <typename M>
+    static void assign_scalar(M& member, ev_t const& ev) noexcept
+    {
+        switch (ev.value_type())
+        {
+            case saj_variant_value::float_number: assign_in_range(member, ev.as_float_number()); break;
+            case saj_variant_value::number: assign_in_range(member, ev.as_number()); break;
+            default: assign_in_range(member, ev.as_bool()); break;
+        }
+    }
+
+    // numbers with a fraction or exponent are converted to integer members through a float, like float_value events,
+    // values that M cannot represent leave member unchanged
+    template <typename M>
+    static void convert_number(void* member, std::string_view span) noexcept
+    {
+        if constexpr (std::is_integral_v<M>)
+        {
+            if (to_integer(span, *static_cast<M*>(member)) != conversion_status::invalid) return;
+        }
+        typename Traits::float_t value{};
+        if (to_float(span, value) != conversion_status::invalid) assign_in_range(*static_cast<M*>(member), value);
+    }
+
+    template <typename M>
+    void begin_value(M& member, ev_t const& ev)
+    {
+        static_assert(is_bound<M>::value || is_container<M>::value || is_text<M>::value || std::is_arithmetic_v<M>,
+                      "members need a binding, or have to be numbers, bool, strings or std::vector");
+        if (!accepts<M>(ev)) return ignore(ev);
+        if constexpr (is_bound<M>::value)
+            frames.push_back({&member, &struct_level<struct_binder, M>::ops});
+        else if constexpr (is_container<M>::value)
+            frames.push_back({&member, &array_level<struct_binder, M>::ops});
+        else if constexpr (is_text<M>::value)
+        {
+            auto const sv = part_of(ev);
+            member.assign(sv.data(), sv.size());
+            text   = &member;
+            append = [](void* t, std::string_view part) { static_cast<M*>(t)->append(part.data(), part.size()); };
+        }
+        else if (ev.event == saj_event::number_value_start)
+        {
+            number_span   = part_of(ev);
+            number        = &member;
+            assign_number = &convert_number<M>;
+        }
+        else
+            assign_scalar(member, ev);
+    }
+
+    void ignore(ev_t const& ev) noexcept
+    {
+        if (ev.event == saj_event::object_start || ev.event == saj_event::array_start) ignored = 1;
+    }
+};
+}  // namespace detail
+
+/// Creates a parser that writes a json object directly into target, all nested objects and arrays have to match bound
+/// structs and vectors of target, values without a member are skipped.
+template <typename EH, typename T>
+auto make_struct_parser(EH&& eh, T& target)
+{
+    using binder_t = detail::struct_binder<default_traits, T, EH>;
+    return detail::extractor_parser<default_traits, table_tag, binder_t>(binder_t(target, std::forward<EH>(eh)));
+}
+
+template <typename OtherTraits, typename EH, typename T>
+auto make_struct_parser(EH&& eh, T& target)
+{
+    using binder_t = detail::struct_binder<OtherTraits, T, EH>;
+    return detail::extractor_parser<OtherTraits, table_tag, binder_t>(binder_t(target, std::forward<EH>(eh)));
+}
+
+}  // namespace async_json
+
+#endif
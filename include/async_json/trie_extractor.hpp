@@ -0,0 +1,227 @@
+/* ==========================================================================
+ Copyright (c) 2024 Andreas Pokorny
+ Distributed under the Boost Software License, Version 1.0. (See accompanying
+ file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+========================================================================== */
+
+#ifndef ASYNC_JSON_TRIE_EXTRACTOR_HPP_INCLUDED
+#define ASYNC_JSON_TRIE_EXTRACTOR_HPP_INCLUDED
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <async_json/json_extractor.hpp>
+
+namespace async_json
+{
+namespace detail
+{
+/// Deterministic automaton over object names built from a set of paths.
+/// Paths with arbitrary elements are merged into the named branches, so every name leads to at most one node.
+struct path_trie
+{
+    static constexpr std::uint32_t no_node = ~std::uint32_t{0};
+    struct node
+    {
+        std::unordered_map<std::string_view, std::uint32_t> named;
+        std::uint32_t                                       other{no_node};  ///< followed by names without a named branch
+        std::vector<std::uint32_t>                          accepting;       ///< paths that end in this node
+    };
+    std::vector<node> nodes;  ///< nodes[0] is the root
+
+    explicit path_trie(std::vector<std::vector<path_element>> const& paths)
+    {
+        // a node is the set of (path, element) pairs that are still matching
+        using state_set = std::vector<std::pair<std::uint32_t, std::uint32_t>>;
+        std::map<state_set, std::uint32_t>               known;
+        std::vector<std::pair<std::uint32_t, state_set>> pending;
+        auto const                                       add_node = [&](state_set set)
+        {
+            if (set.empty()) return no_node;
+            std::sort(set.begin(), set.end());
+            set.erase(std::unique(set.begin(), set.end()), set.end());
+            auto const [it, inserted] = known.emplace(set, static_cast<std::uint32_t>(nodes.size()));
+            if (inserted)
+            {
+                nodes.emplace_back();
+                pending.emplace_back(it->second, std::move(set));
+            }
+            return it->second;
+        };
+        state_set all;
+        for (std::uint32_t p = 0; p != paths.size(); ++p) all.emplace_back(p, 0);
+        nodes.emplace_back();
+        pending.emplace_back(0, std::move(all));
+        known.emplace(pending.back().second, 0);
+
+        while (!pending.empty())
+        {
+            auto [index, set] = std::move(pending.back());
+            pending.pop_back();
+            state_set                             wildcard;
+            std::map<std::string_view, state_set> named;
+            std::vector<std::uint32_t>            accepting;
+            for (auto const& [p, pos] : set)
+            {
+                auto const& elements = paths[p];
+                if (pos == elements.size())
+                    accepting.push_back(p);
+                else if (elements[pos].type == path_type::arbitrary)
+                    wildcard.emplace_back(p, pos + 1);
+                else
+                    named[elements[pos].str].emplace_back(p, pos + 1);
+            }
+            for (auto& [name, targets] : named)
+            {
+                targets.insert(targets.end(), wildcard.begin(), wildcard.end());
+                auto const child = add_node(std::move(targets));
+                nodes[index].named.emplace(name, child);
+            }
+            auto const other       = add_node(std::move(wildcard));
+            nodes[index].other     = other;
+            nodes[index].accepting = std::move(accepting);
+        }
+    }
+
+    std::uint32_t child(std::uint32_t n, std::string_view name) const
+    {
+        if (n == no_node) return no_node;
+        auto const& current = nodes[n];
+        if (auto const it = current.named.find(name); it != current.named.end()) return it->second;
+        return current.other;
+    }
+};
+
+template <typename Tuple, typename Event, std::size_t... Is>
+constexpr auto make_dispatch_table(std::index_sequence<Is...>) noexcept
+{
+    return std::array<void (*)(Tuple&, Event const&), sizeof...(Is)>{{[](Tuple& t, Event const& ev) { std::get<Is>(t)(ev); }...}};
+}
+
+// Handles the events for all paths with one path_trie, the events of a value are only passed to the paths that match it.
+template <typename Traits, typename EH, typename... Fs>
+struct trie_extractor
+{
+    using ev_t        = saj_event_value<Traits>;
+    using functions_t = std::tuple<Fs...>;
+    struct frame
+    {
+        std::uint32_t node;
+        bool          array;
+    };
+    struct delivery
+    {
+        std::uint32_t path;
+        std::size_t   depth;
+    };
+    static constexpr auto dispatch = make_dispatch_table<functions_t, ev_t>(std::index_sequence_for<Fs...>{});
+
+    functions_t           functions;
+    EH                    error_handler;
+    path_trie             trie;
+    std::vector<frame>    frames;
+    std::vector<delivery> deliveries;
+    std::uint32_t         value_node{0};
+    std::string           name;  ///< parts of the current name within a tracked object
+
+    template <typename... Ps>
+    trie_extractor(EH&& eh, Ps&&... ps)
+        : functions{std::forward<Ps>(ps).fun...},
+          error_handler{eh},
+          trie(std::vector<std::vector<path_element>>{ps.is_path.path_elements...})
+    {
+    }
+
+    void operator()(ev_t const& ev)
+    {
+        if (ev.event == saj_event::parse_error)
+        {
+            clear();
+            error_handler(ev.as_error_cause());
+            return;
+        }
+        if (ev.event == saj_event::document_start) clear();
+
+        // arrays are transparent, their elements are matched like the array itself
+        auto const in_array = !frames.empty() && frames.back().array;
+        auto const node     = in_array ? frames.back().node : value_node;
+        if (!in_array && node != path_trie::no_node && begins_value(ev.event))
+            for (auto path : trie.nodes[node].accepting) deliveries.push_back({path, frames.size()});
+        for (auto const& d : deliveries) dispatch[d.path](functions, ev);
+
+        switch (ev.event)
+        {
+            case saj_event::object_start:
+            case saj_event::array_start: frames.push_back({node, ev.event == saj_event::array_start}); break;
+            case saj_event::object_end:
+            case saj_event::array_end: frames.pop_back(); break;
+            case saj_event::object_name_start:
+            case saj_event::object_name_cont:
+            {
+                // the view of a part may end with its input buffer before object_name_end, even without a cont event
+                if (frames.back().node == path_trie::no_node) break;
+                auto const sv = ev.as_string_view();
+                if (ev.event == saj_event::object_name_start) name.clear();
+                name.append(sv.data(), sv.size());
+                break;
+            }
+            case saj_event::object_name_end: value_node = trie.child(frames.back().node, name); break;
+            default: break;
+        }
+
+        if (ends_value(ev.event))
+        {
+            while (!deliveries.empty() && deliveries.back().depth == frames.size()) deliveries.pop_back();
+            if (frames.empty()) value_node = 0;
+        }
+    }
+
+    /// Values that no path can reach are skipped by the parser.
+    bool skip_requested() const noexcept
+    {
+        if (!deliveries.empty()) return false;
+        auto const in_array = !frames.empty() && frames.back().array;
+        return (in_array ? frames.back().node : value_node) == path_trie::no_node;
+    }
+
+    void clear() noexcept
+    {
+        frames.clear();
+        deliveries.clear();
+        value_node = 0;
+    }
+};
+
+template <typename P>
+using path_function_t = std::decay_t<decltype(std::declval<P&>().fun)>;
+}  // namespace detail
+
+/// Creates a parser that matches all paths with a single automaton over object names.
+/// Unlike make_extractor the cost per event does not grow with the number of paths, only path(..) and fast_path(..)
+/// are accepted. Arrays are transparent, every element of an array is matched against the path on its own. This
+/// differs from make_extractor, which loses the array once an element ends after a member that is not on the path,
+/// e.g. of "list", "nested" in {"list": [{"nested": 1}, {"other": 2}, {"nested": 5}]} it only delivers 1.
+template <typename EH, typename... Ps>
+auto make_trie_extractor(EH&& eh, Ps&&... ps)
+{
+    using extractor_t = detail::trie_extractor<default_traits, EH, detail::path_function_t<Ps>...>;
+    return detail::extractor_parser<default_traits, table_tag, extractor_t>(extractor_t(std::forward<EH>(eh), std::forward<Ps>(ps)...));
+}
+
+template <typename OtherTraits, typename EH, typename... Ps>
+auto make_trie_extractor(EH&& eh, Ps&&... ps)
+{
+    using extractor_t = detail::trie_extractor<OtherTraits, EH, detail::path_function_t<Ps>...>;
+    return detail::extractor_parser<OtherTraits, table_tag, extractor_t>(extractor_t(std::forward<EH>(eh), std::forward<Ps>(ps)...));
+}
+
+}  // namespace async_json
+
+#endif
@@ -0,0 +1,146 @@
+#define CATCH_CONFIG_MAIN  // This tells Catch to provide a main() - only do this in one cpp file
+#include <coroutine>
+#include <exception>
+#include <string>
+#include <utility>
+#include <vector>
+#include <async_json/event_stream.hpp>
+#include <catch2/catch.hpp>
+
+namespace a = async_json;
+
+namespace
+{
+struct detached
+{
+    struct promise_type
+    {
+        detached            get_return_object() noexcept { return {}; }
+        std::suspend_never  initial_suspend() noexcept { return {}; }
+        std::suspend_never  final_suspend() noexcept { return {}; }
+        void                return_void() noexcept {}
+        void                unhandled_exception() noexcept { std::terminate(); }
+    };
+};
+
+// stand-in for a socket: a read completes when the test loop calls deliver()
+struct chunk_pipe
+{
+    std::vector<std::string_view> chunks;
+    std::size_t                   next{0};
+    std::coroutine_handle<>       waiting;
+
+    auto read()
+    {
+        struct awaiter
+        {
+            chunk_pipe*      pipe;
+            bool             await_ready() const noexcept { return false; }
+            void             await_suspend(std::coroutine_handle<> h) noexcept { pipe->waiting = h; }
+            std::string_view await_resume() noexcept
+            {
+                return pipe->next < pipe->chunks.size() ? pipe->chunks[pipe->next++] : std::string_view{};
+            }
+        };
+        return awaiter{this};
+    }
+    bool deliver()
+    {
+        if (!waiting) return false;
+        std::exchange(waiting, nullptr).resume();
+        return true;
+    }
+};
+
+struct event_text
+{
+    std::vector<std::string> lines;
+    bool                     finished{false};
+};
+
+detached consume(a::event_stream<> events, event_text& out)
+{
+    while (auto ev = co_await events.next())
+    {
+        switch (ev->event)
+        {
+            case a::saj_event::object_start: out.lines.push_back("{"); break;
+            case a::saj_event::object_end: out.lines.push_back("}"); break;
+            case a::saj_event::array_start: out.lines.push_back("["); break;
+            case a::saj_event::array_end: out.lines.push_back("]"); break;
+            case a::saj_event::object_name_start: out.lines.push_back("name " + std::string(ev->as_string_view())); break;
+            case a::saj_event::object_name_cont: out.lines.back() += std::string(ev->as_string_view()); break;
+            case a::saj_event::string_value_start: out.lines.push_back("string " + std::string(ev->as_string_view())); break;
+            case a::saj_event::string_value_cont: out.lines.back() += std::string(ev->as_string_view()); break;
+            case a::saj_event::integer_value: out.lines.push_back("int " + std::to_string(ev->as_number())); break;
+            case a::saj_event::boolean_value: out.lines.push_back(ev->as_bool() ? "true" : "false"); break;
+            case a::saj_event::parse_error:
+                out.lines.push_back(ev->as_error_cause() == a::incomplete_input ? "incomplete" : "error");
+                break;
+            default: break;
+        }
+    }
+    out.finished = true;
+}
+}  // namespace
+
+TEST_CASE("event stream pulls events from chunks delivered by an awaitable source")
+{
+    chunk_pipe pipe{{R"({"na)", R"(me":"val)", R"(ue", "list":[1,tr)", R"(ue,22]})"}};
+    event_text out;
+    consume(a::parse_events([&pipe] { return pipe.read(); }), out);
+
+    std::size_t deliveries = 0;
+    while (pipe.deliver()) ++deliveries;
+
+    REQUIRE(out.finished);
+    REQUIRE(deliveries == 4);
+    REQUIRE_THAT(out.lines, Catch::Matchers::Equals(std::vector<std::string>{
+                                "{", "name name", "string value", "name list", "[", "int 1", "true", "int 22", "]", "}"}));
+}
+
+TEST_CASE("event stream ends after a parse error")
+{
+    chunk_pipe pipe{{R"([1,)", R"(]])", R"([])"}};
+    event_text out;
+    consume(a::parse_events<a::default_traits, a::unrolled_tag>([&pipe] { return pipe.read(); }), out);
+    while (pipe.deliver())
+        ;
+
+    REQUIRE(out.finished);
+    REQUIRE(pipe.next == 2);
+    REQUIRE_THAT(out.lines, Catch::Matchers::Equals(std::vector<std::string>{"[", "int 1", "error"}));
+}
+
+TEST_CASE("event stream reports input that ends within a value")
+{
+    auto run_test = [](std::vector<std::string_view> chunks, std::vector<std::string> const& expected)
+    {
+        chunk_pipe pipe{std::move(chunks)};
+        event_text out;
+        consume(a::parse_events([&pipe] { return pipe.read(); }), out);
+        while (pipe.deliver())
+            ;
+
+        REQUIRE(out.finished);
+        REQUIRE_THAT(out.lines, Catch::Matchers::Equals(expected));
+    };
+
+    run_test({R"([1, 2)"}, {"[", "int 1", "incomplete"});
+    run_test({R"(["ab)", "cd"}, {"[", "string abcd", "incomplete"});
+    run_test({R"({"na)", "me"}, {"{", "name name", "incomplete"});
+    run_test({"[tr", "u"}, {"[", "incomplete"});
+    run_test({"fal"}, {"incomplete"});
+}
+
+TEST_CASE("event stream completes a top level number at the end of the input")
+{
+    chunk_pipe pipe{{"12", "3"}};
+    event_text out;
+    consume(a::parse_events([&pipe] { return pipe.read(); }), out);
+    while (pipe.deliver())
+        ;
+
+    REQUIRE(out.finished);
+    REQUIRE_THAT(out.lines, Catch::Matchers::Equals(std::vector<std::string>{"int 123"}));
+}
@@ -0,0 +1,168 @@
+#define CATCH_CONFIG_MAIN  // This tells Catch to provide a main() - only do this in one cpp file
+#include <string>
+#include <vector>
+#include <async_json/batched_handler.hpp>
+#include <async_json/indexed_parser.hpp>
+#include <async_json/json_extractor.hpp>
+#include <catch2/catch.hpp>
+
+namespace a = async_json;
+
+namespace
+{
+template <typename Traits = a::default_traits>
+struct recorder
+{
+    std::vector<std::string> events;
+    void                     operator()(a::saj_event_value<Traits> const& ev)
+    {
+        auto entry = std::to_string(static_cast<int>(ev.event));
+        switch (ev.value_type())
+        {
+            case a::saj_variant_value::string:
+            case a::saj_variant_value::raw_number: entry += " " + std::string(ev.as_string_view()); break;
+            case a::saj_variant_value::number: entry += " " + std::to_string(ev.as_number()); break;
+            case a::saj_variant_value::float_number: entry += " " + std::to_string(ev.as_float_number()); break;
+            case a::saj_variant_value::boolean: entry += ev.as_bool() ? " true" : " false"; break;
+            case a::saj_variant_value::error: entry += " " + std::to_string(static_cast<int>(ev.as_error_cause())); break;
+            default: break;
+        }
+        events.push_back(entry);
+    }
+};
+
+template <typename Traits = a::default_traits>
+void require_same_events(std::string_view document)
+{
+    a::basic_json_parser<recorder<Traits>, Traits> streaming;
+    a::basic_json_parser<recorder<Traits>, Traits> indexed;
+    streaming.parse_bytes(document);
+    a::parse_indexed(document, indexed);
+    INFO(document);
+    REQUIRE_THAT(indexed.callback_handler()->events, Catch::Matchers::Equals(streaming.callback_handler()->events));
+}
+}  // namespace
+
+TEST_CASE("indexed parser: same events as the streaming parser")
+{
+    require_same_events(R"({"a":1,"b":[true,false,null],"c":{"d":-12.5e3,"e":"text"}} )");
+    require_same_events(R"([ 1 , 2 ,"three",{ } , [ ] ,{"x" : [ [ ] ] } ] )");
+    require_same_events(R"("just a string")");
+    require_same_events(R"(  42 )");
+    require_same_events(R"({"escaped \"quote\" \\":"back\\slash\\\\","\\\"":"\\"})");
+    require_same_events(R"({"long":")" + std::string(150, 'x') + R"(\"", "next": "value with a \\\\ run that crosses blocks"})");
+    for (std::size_t pad = 0; pad != 70; ++pad)
+        require_same_events(R"([")" + std::string(pad, 'p') + R"(\\\\\\\"\\",{"k":")" + std::string(pad, 'q') + R"(\""}])");
+}
+
+TEST_CASE("indexed parser: errors")
+{
+    require_same_events(R"({"a" 1})");
+    require_same_events(R"({"a":1]})");
+    require_same_events(R"([1 2])");
+    require_same_events(R"([tru])");
+    require_same_events(R"({1:2})");
+    require_same_events(R"([1,]])");
+}
+
+TEST_CASE("indexed parser: numbers")
+{
+    require_same_events(R"([- 5, -
+7, -0.5e-3, 1E+2] )");
+    require_same_events("7]");
+    require_same_events(R"([12345678901234567890, -9223372036854775809, 99999999999999999999999, 9223372036854775807] )");
+}
+
+TEST_CASE("indexed parser: raw numbers")
+{
+    require_same_events<a::raw_number_traits>(R"([1, -2.5, 3e10, {"n":12345678901234567890}] )");
+}
+
+TEST_CASE("indexed parser: decoded escapes")
+{
+    require_same_events<a::decode_escapes_traits>(R"({"n\u00e9":"plain","b":["a\"b\\c\/\n","\ud834\udd20"]} )");
+    require_same_events<a::decode_escapes_traits>(R"(["\x"] )");
+}
+
+TEST_CASE("indexed parser: decoded escapes in batches")
+{
+    using traits = a::decode_escapes_traits;
+    struct batch_recorder
+    {
+        recorder<traits> events;
+        void             operator()(a::saj_event_value<traits> const* first, a::saj_event_value<traits> const* last)
+        {
+            for (; first != last; ++first) events(*first);
+        }
+    };
+    std::string const document = R"({"n\u00e9":"a\"b","k":["\\x","plain","t\/u"]} )";
+    a::basic_json_parser<recorder<traits>, traits>                 streaming;
+    a::basic_batched_json_parser<batch_recorder, traits, a::table_tag, 4> indexed;
+    streaming.parse_bytes(document);
+    a::parse_indexed(document, indexed);
+    REQUIRE_THAT(indexed.callback_handler()->consumer.events.events, Catch::Matchers::Equals(streaming.callback_handler()->events));
+}
+
+TEST_CASE("indexed parser: utf-8 validation")
+{
+    require_same_events<a::validate_utf8_traits>("{\"n\xc3\xa9\":[\"\xe2\x82\xac\",\"plain\"]} ");
+    require_same_events<a::validate_utf8_traits>("[\"\xed\xa0\x80\"] ");
+    require_same_events<a::validate_utf8_traits>("{\"\xe2\x82\":1} ");
+}
+
+TEST_CASE("indexed parser: multi document streams")
+{
+    require_same_events<a::multi_document_traits>("{\"a\":1} [2]\n3 \"x\"\ntrue\n");
+    require_same_events<a::multi_document_traits>("{\"a\" 1}\n{\"b\":[1,\n2]}\n] [3]\n");
+    require_same_events<a::multi_document_traits>("[\"open\" x \"quote\n[\"next\", \"line\"]\n{\"c\":\"d\"} ");
+    require_same_events<a::multi_document_traits>("[1] {\"a\":");
+    require_same_events<a::multi_document_traits>("[1] }");
+    require_same_events<a::multi_document_traits>("2]\n-1.5e3}\n3 ]\n");
+}
+
+TEST_CASE("indexed parser: many bad lines")
+{
+    // bad lines that end within a string switch between the index of the document and the one scanned after them
+    std::string lines;
+    for (int i = 0; i != 600; ++i)
+    {
+        switch (i % 6)
+        {
+            case 0: lines += "{\"id\":" + std::to_string(i) + ",\"name\":\"ok\"}\n"; break;
+            case 1: lines += "{\"id\":" + std::to_string(i) + " \"name\":\"bad\"}\n"; break;
+            case 2: lines += "{\"id\":" + std::to_string(i) + ",\"name\":\"cut\n"; break;
+            case 3: lines += "[\"a\", \"b\"] x \"c\", [1,\n2]\n"; break;
+            case 4: lines += "\"open\" \"quote\" } \"dangling\n"; break;
+            default: lines += "[\"esc \\\" quote\", tru]\n"; break;
+        }
+    }
+    lines += "{\"last\":true}\n";
+    require_same_events<a::multi_document_traits>(lines);
+}
+
+TEST_CASE("indexed parser: extractor paths")
+{
+    std::string name;
+    long        id{0};
+    std::string token;
+    auto        extractor = a::make_extractor([](a::error_cause) {},                        //
+                                       a::path(a::assign_string(name), "user", "name"),  //
+                                       a::path(a::assign_numeric(id), "user", "id"),     //
+                                       a::path(a::assign_string(token), "token"));
+    std::string const document =
+        R"({"items":[1,2,{"name":"skip"}],"user":{"name":"ada","id":7},"token":")" +
+        std::string(100, 't') + R"("})";
+
+    REQUIRE(a::parse_indexed(document, extractor) == a::parse_status::done);
+    REQUIRE(name == "ada");
+    REQUIRE(id == 7);
+    REQUIRE(token == std::string(100, 't'));
+}
+
+TEST_CASE("indexed parser: truncated document")
+{
+    a::basic_json_parser<recorder<>> parser;
+    REQUIRE(a::parse_indexed(std::string_view(R"({"a":[1,2)"), parser) == a::parse_status::need_more);
+    a::basic_json_parser<recorder<>> unclosed;
+    REQUIRE(a::parse_indexed(std::string_view(R"({"a":"open)"), unclosed) == a::parse_status::need_more);
+}
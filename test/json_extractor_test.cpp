@@ -1,6 +1,8 @@
 #define CATCH_CONFIG_MAIN  // This tells Catch to provide a main() - only do this in one cpp file
 #include <iostream>
+#include <array>
 #include <iomanip>
+#include <memory_resource>
 #include <vector>
 #include <functional>
 #include <async_json/json_extractor.hpp>
@@ -215,3 +217,88 @@ TEST_CASE("JSON on_exit[fast]: called once")
     extractor.parse_bytes(std::string_view(val, sizeof(val)));
     REQUIRE(called== 1);
 }
+
+TEST_CASE("JSON Path: values off all paths are skipped")
+{
+    using namespace std::literals;
+    auto const val = R"({"big": {"foo": [1, {"x": "}\""}], "bar": 3}, "bar": {"other": [[{}]], "foo": 7}, "name": "n"} )"sv;
+    for (size_t split = 0; split != val.size(); ++split)
+    {
+        long        foo{13};
+        std::string name;
+        auto        extractor = a::make_extractor([](a::error_cause er) { std::cout << "ERROR" << static_cast<int>(er) << " \n"; },
+                                           a::path(a::assign_numeric(foo), "bar", "foo"), a::path(a::assign_string(name), "name"));
+        extractor.parse_bytes(val.substr(0, split));
+        extractor.parse_bytes(val.substr(split));
+        REQUIRE(foo == 7);
+        REQUIRE(name == "n");
+    }
+}
+
+TEST_CASE("JSON Path: skipping is requested only when all paths are off path")
+{
+    long foo{13};
+    auto extractor = a::make_extractor([](a::error_cause) {}, a::path(a::assign_numeric(foo), "bar", "foo"));
+    extractor.parse_bytes(R"({"big":)");
+    REQUIRE(extractor.callback_handler()->skip_requested());
+    extractor.parse_bytes(R"( 1, "bar":)");
+    REQUIRE_FALSE(extractor.callback_handler()->skip_requested());
+
+    auto all_events = a::make_extractor([](a::error_cause) {}, a::path(a::assign_numeric(foo), "bar", "foo"), [](auto const&) {});
+    all_events.parse_bytes(R"({"big":)");
+    REQUIRE_FALSE(all_events.callback_handler()->skip_requested());
+}
+
+TEST_CASE("JSON Path: pmr containers allocate from their memory resource")
+{
+    constexpr char                      val[] = R"({"items": [{"name": "a name that is too long for small strings"}, {"name": "b"}]} )";
+    std::array<std::byte, 1024>         buffer;
+    std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size(), std::pmr::null_memory_resource());
+    std::pmr::vector<std::pmr::string>  names(&arena);
+    static_assert(a::is_container<std::pmr::vector<std::pmr::string>>::value);
+
+    auto extractor = a::make_extractor([](a::error_cause er) { std::cout << "ERROR" << static_cast<int>(er) << " \n"; },
+                                       a::path(a::assign_string(names), "items", "name"));
+    extractor.parse_bytes(std::string_view(val, sizeof(val)));
+    REQUIRE(names.size() == 2);
+    REQUIRE(names[0] == "a name that is too long for small strings");
+    REQUIRE(names[1] == "b");
+    REQUIRE(names[0].get_allocator().resource() == &arena);
+}
+
+TEST_CASE("JSON Path: strings copied into a memory resource")
+{
+    using namespace std::literals;
+    auto const val = R"({"name": "split name", "tags": ["x", "yz"]} )"sv;
+    for (size_t split = 0; split != val.size(); ++split)
+    {
+        std::array<std::byte, 256>          buffer;
+        std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size(), std::pmr::null_memory_resource());
+        std::string_view                    name;
+        std::pmr::vector<std::string_view>  tags(&arena);
+        auto extractor = a::make_extractor([](a::error_cause er) { std::cout << "ERROR" << static_cast<int>(er) << " \n"; },
+                                           a::path(a::assign_string(name, arena), "name"), a::path(a::assign_string(tags, arena), "tags"));
+        extractor.parse_bytes(val.substr(0, split));
+        extractor.parse_bytes(val.substr(split));
+        REQUIRE(name == "split name");
+        REQUIRE(tags.size() == 2);
+        REQUIRE(tags[1] == "yz");
+        auto const in_arena = [&](std::string_view sv)
+        { return static_cast<void const*>(sv.data()) >= buffer.data() && static_cast<void const*>(sv.data()) < buffer.data() + buffer.size(); };
+        REQUIRE(in_arena(name));
+        REQUIRE(in_arena(tags[0]));
+    }
+}
+
+TEST_CASE("JSON Path: strings split into many parts grow geometrically in a memory resource")
+{
+    std::string const val = R"({"name": ")" + std::string(2000, 'n') + R"("} )";
+    // copying the collected string for every part would need about 2 MB
+    std::array<std::byte, 8192>         buffer;
+    std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size(), std::pmr::null_memory_resource());
+    std::string_view                    name;
+    auto extractor = a::make_extractor([](a::error_cause er) { std::cout << "ERROR" << static_cast<int>(er) << " \n"; },
+                                       a::path(a::assign_string(name, arena), "name"));
+    for (char const& c : val) extractor.parse_bytes(std::string_view(&c, 1));
+    REQUIRE(name == std::string(2000, 'n'));
+}
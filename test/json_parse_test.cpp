@@ -1,9 +1,11 @@
 #define CATCH_CONFIG_MAIN  // This tells Catch to provide a main() - only do this in one cpp file
 #include <iostream>
 #include <iomanip>
+#include <utility>
 #include <vector>
 #include <async_json/basic_json_parser.hpp>
 #include <async_json/saj_event_value.hpp>
+#include <async_json/batched_handler.hpp>
 #include <catch2/catch.hpp>
 
 namespace a = async_json;
@@ -19,7 +21,7 @@ struct call
     call(a::saj_event_value<Traits> const& ev) : callt{ev.event}
     {
         using a::saj_event;
-        if (callt == saj_event::string_value_start || callt == saj_event::object_name_start)
+        if (callt == saj_event::string_value_start || callt == saj_event::object_name_start || callt == saj_event::number_value_start)
             buf = ev.as_string_view();
         else if (callt == saj_event::integer_value)
             value = ev.as_number();
@@ -49,6 +51,8 @@ struct call
             case a::saj_event::string_value_start: return o << '"' << rhs.buf << '"' << ":";
             case a::saj_event::integer_value: return o << rhs.value;
             case a::saj_event::float_value: return o << rhs.float_val;
+            case a::saj_event::number_value_start: return o << rhs.buf;
+            default: break;
         }
         return o;
     }
@@ -71,6 +75,10 @@ constexpr const char* error_str(a::error_cause cause)
         case a::unexpected_character: return "unexpected character";
         case a::comma_expected: return "comma expected";
         case a::invalid_number: return "invalid character in number";
+        case a::nesting_too_deep: return "nesting too deep";
+        case a::invalid_escape: return "invalid escape sequence";
+        case a::invalid_utf8: return "invalid utf-8";
+        case a::incomplete_input: return "incomplete input";
         default: return "no error";
     }
 }
@@ -94,9 +102,11 @@ struct test_handler
     void operator()(a::saj_event_value<T> const& value)
     {
         // filters out _end events and appends all _cont tokens to start
-        if (value.event == a::saj_event::string_value_cont || value.event == a::saj_event::object_name_cont)
+        if (value.event == a::saj_event::string_value_cont || value.event == a::saj_event::object_name_cont ||
+            value.event == a::saj_event::number_value_cont)
             calls.back().buf += std::string(value.as_string_view());
-        else if (value.event != a::saj_event::string_value_end && value.event != a::saj_event::object_name_end)
+        else if (value.event != a::saj_event::string_value_end && value.event != a::saj_event::object_name_end &&
+                 value.event != a::saj_event::number_value_end)
             calls.push_back(call(value));
     }
     friend std::ostream& operator<<(std::ostream& o, test_handler const& rhs)
@@ -117,6 +127,7 @@ TEST_CASE("Detect keywords: null")
 
     run_test(a::basic_json_parser<test_handler<>>{});
     run_test(a::basic_json_parser<test_handler<>, a::default_traits, a::unrolled_tag>{});
+    run_test(a::basic_json_parser<test_handler<>, a::default_traits, a::fused_tag>{});
 }
 
 TEST_CASE("Detect keywords: true")
@@ -130,6 +141,7 @@ TEST_CASE("Detect keywords: true")
 
     run_test(a::basic_json_parser<test_handler<>>{});
     run_test(a::basic_json_parser<test_handler<>, a::default_traits, a::unrolled_tag>{});
+    run_test(a::basic_json_parser<test_handler<>, a::default_traits, a::fused_tag>{});
 }
 
 TEST_CASE("Detect keywords: false")
@@ -143,6 +155,7 @@ TEST_CASE("Detect keywords: false")
 
     run_test(a::basic_json_parser<test_handler<>>{});
     run_test(a::basic_json_parser<test_handler<>, a::default_traits, a::unrolled_tag>{});
+    run_test(a::basic_json_parser<test_handler<>, a::default_traits, a::fused_tag>{});
 }
 
 TEST_CASE("Error in keyword: false")
@@ -157,6 +170,7 @@ TEST_CASE("Error in keyword: false")
 
     run_test(a::basic_json_parser<test_handler<>>{});
     run_test(a::basic_json_parser<test_handler<>, a::default_traits, a::unrolled_tag>{});
+    run_test(a::basic_json_parser<test_handler<>, a::default_traits, a::fused_tag>{});
 }
 TEST_CASE("parse empty object")
 {
@@ -170,6 +184,7 @@ TEST_CASE("parse empty object")
 
     run_test(a::basic_json_parser<test_handler<>>{});
     run_test(a::basic_json_parser<test_handler<>, a::default_traits, a::unrolled_tag>{});
+    run_test(a::basic_json_parser<test_handler<>, a::default_traits, a::fused_tag>{});
 }
 TEST_CASE("Error: object expects member name")
 {
@@ -183,6 +198,7 @@ TEST_CASE("Error: object expects member name")
 
     run_test(a::basic_json_parser<test_handler<>>{});
     run_test(a::basic_json_parser<test_handler<>, a::default_traits, a::unrolled_tag>{});
+    run_test(a::basic_json_parser<test_handler<>, a::default_traits, a::fused_tag>{});
 }
 
 TEST_CASE("Parse named object")
@@ -200,6 +216,7 @@ TEST_CASE("Parse named object")
 
     run_test(a::basic_json_parser<test_handler<>>{});
     run_test(a::basic_json_parser<test_handler<>, a::default_traits, a::unrolled_tag>{});
+    run_test(a::basic_json_parser<test_handler<>, a::default_traits, a::fused_tag>{});
 }
 
 TEST_CASE("Parse empty array")
@@ -217,6 +234,7 @@ TEST_CASE("Parse empty array")
 
     run_test(a::basic_json_parser<test_handler<>>{});
     run_test(a::basic_json_parser<test_handler<>, a::default_traits, a::unrolled_tag>{});
+    run_test(a::basic_json_parser<test_handler<>, a::default_traits, a::fused_tag>{});
 }
 
 TEST_CASE("Error unmatched array close")
@@ -233,6 +251,7 @@ TEST_CASE("Error unmatched array close")
 
     run_test(a::basic_json_parser<test_handler<>>{});
     run_test(a::basic_json_parser<test_handler<>, a::default_traits, a::unrolled_tag>{});
+    run_test(a::basic_json_parser<test_handler<>, a::default_traits, a::fused_tag>{});
 }
 
 TEST_CASE("Error object members must be named")
@@ -250,6 +269,7 @@ TEST_CASE("Error object members must be named")
 
     run_test(a::basic_json_parser<test_handler<>>{});
     run_test(a::basic_json_parser<test_handler<>, a::default_traits, a::unrolled_tag>{});
+    run_test(a::basic_json_parser<test_handler<>, a::default_traits, a::fused_tag>{});
 }
 
 TEST_CASE("String values")
@@ -268,6 +288,7 @@ TEST_CASE("String values")
 
     run_test(a::basic_json_parser<test_handler<>>{});
     run_test(a::basic_json_parser<test_handler<>, a::default_traits, a::unrolled_tag>{});
+    run_test(a::basic_json_parser<test_handler<>, a::default_traits, a::fused_tag>{});
 }
 
 TEST_CASE("Array : strings")
@@ -286,6 +307,7 @@ TEST_CASE("Array : strings")
 
     run_test(a::basic_json_parser<test_handler<>>{});
     run_test(a::basic_json_parser<test_handler<>, a::default_traits, a::unrolled_tag>{});
+    run_test(a::basic_json_parser<test_handler<>, a::default_traits, a::fused_tag>{});
 }
 
 TEST_CASE("Array : error: comma seperation")
@@ -304,6 +326,7 @@ TEST_CASE("Array : error: comma seperation")
 
     run_test(a::basic_json_parser<test_handler<>>{});
     run_test(a::basic_json_parser<test_handler<>, a::default_traits, a::unrolled_tag>{});
+    run_test(a::basic_json_parser<test_handler<>, a::default_traits, a::fused_tag>{});
 }
 
 TEST_CASE("Number: integer number")
@@ -317,6 +340,7 @@ TEST_CASE("Number: integer number")
 
     run_test(a::basic_json_parser<test_handler<>>{});
     run_test(a::basic_json_parser<test_handler<>, a::default_traits, a::unrolled_tag>{});
+    run_test(a::basic_json_parser<test_handler<>, a::default_traits, a::fused_tag>{});
 }
 
 TEST_CASE("Number: negative integer number")
@@ -330,6 +354,7 @@ TEST_CASE("Number: negative integer number")
 
     run_test(a::basic_json_parser<test_handler<>>{});
     run_test(a::basic_json_parser<test_handler<>, a::default_traits, a::unrolled_tag>{});
+    run_test(a::basic_json_parser<test_handler<>, a::default_traits, a::fused_tag>{});
 }
 
 TEST_CASE("Number: double number")
@@ -343,6 +368,7 @@ TEST_CASE("Number: double number")
 
     run_test(a::basic_json_parser<test_handler<>>{});
     run_test(a::basic_json_parser<test_handler<>, a::default_traits, a::unrolled_tag>{});
+    run_test(a::basic_json_parser<test_handler<>, a::default_traits, a::fused_tag>{});
 }
 
 TEST_CASE("Number: negative double number")
@@ -357,6 +383,7 @@ TEST_CASE("Number: negative double number")
 
     run_test(a::basic_json_parser<test_handler<>>{});
     run_test(a::basic_json_parser<test_handler<>, a::default_traits, a::unrolled_tag>{});
+    run_test(a::basic_json_parser<test_handler<>, a::default_traits, a::fused_tag>{});
 }
 
 TEST_CASE("Number: exponent number")
@@ -370,6 +397,7 @@ TEST_CASE("Number: exponent number")
 
     run_test(a::basic_json_parser<test_handler<>>{});
     run_test(a::basic_json_parser<test_handler<>, a::default_traits, a::unrolled_tag>{});
+    run_test(a::basic_json_parser<test_handler<>, a::default_traits, a::fused_tag>{});
 }
 
 TEST_CASE("Number: Exponent number")
@@ -383,6 +411,7 @@ TEST_CASE("Number: Exponent number")
 
     run_test(a::basic_json_parser<test_handler<>>{});
     run_test(a::basic_json_parser<test_handler<>, a::default_traits, a::unrolled_tag>{});
+    run_test(a::basic_json_parser<test_handler<>, a::default_traits, a::fused_tag>{});
 }
 
 TEST_CASE("Number: float number")
@@ -396,6 +425,7 @@ TEST_CASE("Number: float number")
 
     run_test(a::basic_json_parser<test_handler<sp_float>, sp_float>{});
     run_test(a::basic_json_parser<test_handler<sp_float>, sp_float, a::unrolled_tag>{});
+    run_test(a::basic_json_parser<test_handler<sp_float>, sp_float, a::fused_tag>{});
 }
 
 TEST_CASE("Array : integers")
@@ -414,6 +444,7 @@ TEST_CASE("Array : integers")
 
     run_test(a::basic_json_parser<test_handler<>>{});
     run_test(a::basic_json_parser<test_handler<>, a::default_traits, a::unrolled_tag>{});
+    run_test(a::basic_json_parser<test_handler<>, a::default_traits, a::fused_tag>{});
 }
 
 TEST_CASE("Array : doubles")
@@ -432,6 +463,7 @@ TEST_CASE("Array : doubles")
 
     run_test(a::basic_json_parser<test_handler<>>{});
     run_test(a::basic_json_parser<test_handler<>, a::default_traits, a::unrolled_tag>{});
+    run_test(a::basic_json_parser<test_handler<>, a::default_traits, a::fused_tag>{});
 }
 
 TEST_CASE("partial input on text value")
@@ -450,6 +482,7 @@ TEST_CASE("partial input on text value")
 
     run_test(a::basic_json_parser<test_handler<>>{});
     run_test(a::basic_json_parser<test_handler<>, a::default_traits, a::unrolled_tag>{});
+    run_test(a::basic_json_parser<test_handler<>, a::default_traits, a::fused_tag>{});
 }
 
 TEST_CASE("partial input on text value 2")
@@ -468,6 +501,7 @@ TEST_CASE("partial input on text value 2")
 
     run_test(a::basic_json_parser<test_handler<>>{});
     run_test(a::basic_json_parser<test_handler<>, a::default_traits, a::unrolled_tag>{});
+    run_test(a::basic_json_parser<test_handler<>, a::default_traits, a::fused_tag>{});
 }
 
 TEST_CASE("partial input on text value 3")
@@ -488,6 +522,7 @@ TEST_CASE("partial input on text value 3")
 
     run_test(a::basic_json_parser<test_handler<>>{});
     run_test(a::basic_json_parser<test_handler<>, a::default_traits, a::unrolled_tag>{});
+    run_test(a::basic_json_parser<test_handler<>, a::default_traits, a::fused_tag>{});
 }
 
 TEST_CASE("partial input on object name")
@@ -511,6 +546,7 @@ TEST_CASE("partial input on object name")
 
     run_test(a::basic_json_parser<test_handler<>>{});
     run_test(a::basic_json_parser<test_handler<>, a::default_traits, a::unrolled_tag>{});
+    run_test(a::basic_json_parser<test_handler<>, a::default_traits, a::fused_tag>{});
 }
 
 TEST_CASE("escape sequences")
@@ -528,5 +564,639 @@ TEST_CASE("escape sequences")
 
     run_test(a::basic_json_parser<test_handler<>>{});
     run_test(a::basic_json_parser<test_handler<>, a::default_traits, a::unrolled_tag>{});
+    run_test(a::basic_json_parser<test_handler<>, a::default_traits, a::fused_tag>{});
 }
 
+
+TEST_CASE("long strings and names split at every position")
+{
+    using namespace std::literals;
+    auto const input =
+        R"({ "an object name that is longer than a single simd block": "a value with \"escapes\" and a \\ that spans more than 64 bytes", "k\\": "v\\"} )"sv;
+    auto const expected = std::vector<call>{
+        {a::saj_event::object_start},
+        {a::saj_event::object_name_start, 0, "an object name that is longer than a single simd block"},
+        {a::saj_event::string_value_start, 0, R"(a value with \"escapes\" and a \\ that spans more than 64 bytes)"},
+        {a::saj_event::object_name_start, 0, R"(k\\)"},
+        {a::saj_event::string_value_start, 0, R"(v\\)"},
+        {a::saj_event::object_end}};
+    auto run_test = [&](auto&& p, size_t split)
+    {
+        p.parse_bytes(input.substr(0, split));
+        p.parse_bytes(input.substr(split));
+        REQUIRE_THAT(p.callback_handler()->calls, Catch::Matchers::Equals(expected));
+    };
+
+    for (size_t split = 0; split <= input.size(); ++split)
+    {
+        run_test(a::basic_json_parser<test_handler<>>{}, split);
+        run_test(a::basic_json_parser<test_handler<>, a::default_traits, a::unrolled_tag>{}, split);
+        run_test(a::basic_json_parser<test_handler<>, a::default_traits, a::fused_tag>{}, split);
+    }
+}
+
+TEST_CASE("pretty printed input split at every position")
+{
+    using namespace std::literals;
+    auto const input = "{\n    \"a\"   :\t[\r\n                                        1,\n        {  }  ,\n        \"x\"\n    ]\n  ,\"b\":true}\n"sv;
+    auto const expected = std::vector<call>{{a::saj_event::object_start},     {a::saj_event::object_name_start, 0, "a"},
+                                            {a::saj_event::array_start},      {a::saj_event::integer_value, 1},
+                                            {a::saj_event::object_start},     {a::saj_event::object_end},
+                                            {a::saj_event::string_value_start, 0, "x"},
+                                            {a::saj_event::array_end},        {a::saj_event::object_name_start, 0, "b"},
+                                            {a::saj_event::boolean_value, 1}, {a::saj_event::object_end}};
+    auto run_test = [&](auto&& p, size_t split)
+    {
+        p.parse_bytes(input.substr(0, split));
+        p.parse_bytes(input.substr(split));
+        REQUIRE_THAT(p.callback_handler()->calls, Catch::Matchers::Equals(expected));
+    };
+
+    for (size_t split = 0; split <= input.size(); ++split)
+    {
+        run_test(a::basic_json_parser<test_handler<>>{}, split);
+        run_test(a::basic_json_parser<test_handler<>, a::default_traits, a::unrolled_tag>{}, split);
+        run_test(a::basic_json_parser<test_handler<>, a::default_traits, a::fused_tag>{}, split);
+    }
+}
+
+TEST_CASE("long numbers split at every position")
+{
+    using namespace std::literals;
+    auto const input    = "[1234567890123456789, -98765432109876,1234.125, 98765.5e3, 2E10 ,0.000244140625]"sv;
+    auto const expected = std::vector<call>{{a::saj_event::array_start},
+                                            {a::saj_event::integer_value, 1234567890123456789},
+                                            {a::saj_event::integer_value, -98765432109876},
+                                            {a::saj_event::float_value, 0, "", 1234.125},
+                                            {a::saj_event::float_value, 0, "", 98765500.0},
+                                            {a::saj_event::float_value, 0, "", 2E10},
+                                            {a::saj_event::float_value, 0, "", 0.000244140625},
+                                            {a::saj_event::array_end}};
+    auto run_test = [&](auto&& p, size_t split)
+    {
+        p.parse_bytes(input.substr(0, split));
+        p.parse_bytes(input.substr(split));
+        REQUIRE_THAT(p.callback_handler()->calls, Catch::Matchers::Equals(expected));
+    };
+
+    for (size_t split = 0; split <= input.size(); ++split)
+    {
+        run_test(a::basic_json_parser<test_handler<>>{}, split);
+        run_test(a::basic_json_parser<test_handler<>, a::default_traits, a::unrolled_tag>{}, split);
+        run_test(a::basic_json_parser<test_handler<>, a::default_traits, a::fused_tag>{}, split);
+    }
+}
+
+TEST_CASE("floats are correctly rounded when split at every position")
+{
+    using namespace std::literals;
+    auto const input =
+        "[0.1,2.2250738585072011e-308, 1.5e+3,3.14159265358979323846264338327950288,-122.41941550000001, 9007199254740993.0,1e-400]"sv;
+    auto const expected = std::vector<call>{{a::saj_event::array_start},
+                                            {a::saj_event::float_value, 0, "", 0.1},
+                                            {a::saj_event::float_value, 0, "", 2.2250738585072011e-308},
+                                            {a::saj_event::float_value, 0, "", 1500.0},
+                                            {a::saj_event::float_value, 0, "", 3.14159265358979323846264338327950288},
+                                            {a::saj_event::float_value, 0, "", -122.41941550000001},
+                                            {a::saj_event::float_value, 0, "", 9007199254740992.0},
+                                            {a::saj_event::float_value, 0, "", 0.0},
+                                            {a::saj_event::array_end}};
+    auto run_test = [&](auto&& p, size_t split)
+    {
+        p.parse_bytes(input.substr(0, split));
+        p.parse_bytes(input.substr(split));
+        REQUIRE_THAT(p.callback_handler()->calls, Catch::Matchers::Equals(expected));
+    };
+
+    for (size_t split = 0; split <= input.size(); ++split)
+    {
+        run_test(a::basic_json_parser<test_handler<>>{}, split);
+        run_test(a::basic_json_parser<test_handler<>, a::default_traits, a::unrolled_tag>{}, split);
+        run_test(a::basic_json_parser<test_handler<>, a::default_traits, a::fused_tag>{}, split);
+    }
+}
+
+TEST_CASE("raw numbers are reported as spans")
+{
+    auto run_test = [](auto&& p)
+    {
+        char const input_buffer[] = R"( [12, -3.5e+2,{"id":123456789012345678901234567890}, 0.25] )";
+        p.parse_bytes(std::string_view(input_buffer, sizeof(input_buffer)));
+        REQUIRE_THAT(p.callback_handler()->calls,
+                     Catch::Matchers::Equals(std::vector<call>{{a::saj_event::array_start},
+                                                               {a::saj_event::number_value_start, 0, "12"},
+                                                               {a::saj_event::number_value_start, 0, "-3.5e+2"},
+                                                               {a::saj_event::object_start},
+                                                               {a::saj_event::object_name_start, 0, "id"},
+                                                               {a::saj_event::number_value_start, 0, "123456789012345678901234567890"},
+                                                               {a::saj_event::object_end},
+                                                               {a::saj_event::number_value_start, 0, "0.25"},
+                                                               {a::saj_event::array_end}}));
+    };
+
+    run_test(a::basic_json_parser<test_handler<a::raw_number_traits>, a::raw_number_traits>{});
+    run_test(a::basic_json_parser<test_handler<a::raw_number_traits>, a::raw_number_traits, a::unrolled_tag>{});
+    run_test(a::basic_json_parser<test_handler<a::raw_number_traits>, a::raw_number_traits, a::fused_tag>{});
+}
+
+TEST_CASE("raw numbers split at every position")
+{
+    using namespace std::literals;
+    auto const input    = "[1234567890123456789,-0.5e-7 ]"sv;
+    auto const expected = std::vector<call>{{a::saj_event::array_start},
+                                            {a::saj_event::number_value_start, 0, "1234567890123456789"},
+                                            {a::saj_event::number_value_start, 0, "-0.5e-7"},
+                                            {a::saj_event::array_end}};
+    auto run_test = [&](auto&& p, size_t split)
+    {
+        p.parse_bytes(input.substr(0, split));
+        p.parse_bytes(input.substr(split));
+        REQUIRE_THAT(p.callback_handler()->calls, Catch::Matchers::Equals(expected));
+    };
+
+    for (size_t split = 0; split <= input.size(); ++split)
+    {
+        run_test(a::basic_json_parser<test_handler<a::raw_number_traits>, a::raw_number_traits>{}, split);
+        run_test(a::basic_json_parser<test_handler<a::raw_number_traits>, a::raw_number_traits, a::unrolled_tag>{}, split);
+        run_test(a::basic_json_parser<test_handler<a::raw_number_traits>, a::raw_number_traits, a::fused_tag>{}, split);
+    }
+}
+
+TEST_CASE("batched events are flushed when full and at the end of the input")
+{
+    struct batch_collector
+    {
+        test_handler<>      events;
+        std::vector<size_t> batch_sizes;
+        void                operator()(a::saj_event_value<a::default_traits> const* first, a::saj_event_value<a::default_traits> const* last)
+        {
+            batch_sizes.push_back(static_cast<size_t>(last - first));
+            for (; first != last; ++first) events(*first);
+        }
+    };
+    auto run_test = [](auto&& p)
+    {
+        using namespace std::literals;
+        p.parse_bytes(R"({"a": [1, 2.5, "x"], "b")"sv);
+        p.parse_bytes(R"(: null} )"sv);
+        auto const& collector = p.callback_handler()->consumer;
+        REQUIRE_THAT(collector.batch_sizes, Catch::Matchers::Equals(std::vector<size_t>{4, 4, 3, 2}));
+        REQUIRE_THAT(collector.events.calls, Catch::Matchers::Equals(std::vector<call>{{a::saj_event::object_start},
+                                                                                       {a::saj_event::object_name_start, 0, "a"},
+                                                                                       {a::saj_event::array_start},
+                                                                                       {a::saj_event::integer_value, 1},
+                                                                                       {a::saj_event::float_value, 0, "", 2.5},
+                                                                                       {a::saj_event::string_value_start, 0, "x"},
+                                                                                       {a::saj_event::array_end},
+                                                                                       {a::saj_event::object_name_start, 0, "b"},
+                                                                                       {a::saj_event::null_value},
+                                                                                       {a::saj_event::object_end}}));
+    };
+
+    run_test(a::basic_batched_json_parser<batch_collector, a::default_traits, a::table_tag, 4>{});
+    run_test(a::basic_batched_json_parser<batch_collector, a::default_traits, a::unrolled_tag, 4>{});
+}
+
+TEST_CASE("batched events keep decoded strings until the consumer returns")
+{
+    using traits = a::decode_escapes_traits;
+    struct batch_collector
+    {
+        test_handler<traits> events;
+        void operator()(a::saj_event_value<traits> const* first, a::saj_event_value<traits> const* last)
+        {
+            for (; first != last; ++first) events(*first);
+        }
+    };
+    using namespace std::literals;
+    auto const input    = R"({"n\u00e9": "a\"b", "k": ["\\x", "plain", "t\/u"]} )"sv;
+    auto const expected = std::vector<call>{{a::saj_event::object_start},
+                                            {a::saj_event::object_name_start, 0, "n\xc3\xa9"},
+                                            {a::saj_event::string_value_start, 0, "a\"b"},
+                                            {a::saj_event::object_name_start, 0, "k"},
+                                            {a::saj_event::array_start},
+                                            {a::saj_event::string_value_start, 0, "\\x"},
+                                            {a::saj_event::string_value_start, 0, "plain"},
+                                            {a::saj_event::string_value_start, 0, "t/u"},
+                                            {a::saj_event::array_end},
+                                            {a::saj_event::object_end}};
+    auto run_test = [&](auto&& p, size_t split)
+    {
+        p.parse_bytes(input.substr(0, split));
+        p.parse_bytes(input.substr(split));
+        REQUIRE_THAT(p.callback_handler()->consumer.events.calls, Catch::Matchers::Equals(expected));
+    };
+
+    for (size_t split = 0; split <= input.size(); ++split)
+    {
+        run_test(a::basic_batched_json_parser<batch_collector, traits, a::table_tag, 4>{}, split);
+        run_test(a::basic_batched_json_parser<batch_collector, traits, a::unrolled_tag, 4>{}, split);
+        run_test(a::basic_batched_json_parser<batch_collector, traits, a::fused_tag, 4>{}, split);
+    }
+}
+
+TEST_CASE("keywords split at every position")
+{
+    using namespace std::literals;
+    auto const input    = R"([true,false, null,{"a":true ,"b":nul}])"sv;
+    auto const expected = std::vector<call>{{a::saj_event::array_start},
+                                            {a::saj_event::boolean_value, true},
+                                            {a::saj_event::boolean_value, false},
+                                            {a::saj_event::null_value},
+                                            {a::saj_event::object_start},
+                                            {a::saj_event::object_name_start, 0, "a"},
+                                            {a::saj_event::boolean_value, true},
+                                            {a::saj_event::object_name_start, 0, "b"},
+                                            {a::saj_event::parse_error, a::wrong_keyword_character}};
+    auto run_test = [&](auto&& p, size_t split)
+    {
+        p.parse_bytes(input.substr(0, split));
+        p.parse_bytes(input.substr(split));
+        REQUIRE_THAT(p.callback_handler()->calls, Catch::Matchers::Equals(expected));
+    };
+
+    for (size_t split = 0; split <= input.size(); ++split)
+    {
+        run_test(a::basic_json_parser<test_handler<>>{}, split);
+        run_test(a::basic_json_parser<test_handler<>, a::default_traits, a::unrolled_tag>{}, split);
+        run_test(a::basic_json_parser<test_handler<>, a::default_traits, a::fused_tag>{}, split);
+    }
+}
+
+TEST_CASE("nesting deeper than max_depth is an error")
+{
+    using traits = a::max_depth_traits<3>;
+    auto run_test = [](auto&& p, std::string_view input, std::vector<call> const& expected)
+    {
+        p.parse_bytes(input);
+        REQUIRE_THAT(p.callback_handler()->calls, Catch::Matchers::Equals(expected));
+    };
+    auto const within   = std::vector<call>{{a::saj_event::array_start},
+                                            {a::saj_event::object_start},
+                                            {a::saj_event::object_name_start, 0, "a"},
+                                            {a::saj_event::array_start},
+                                            {a::saj_event::array_end},
+                                            {a::saj_event::object_end},
+                                            {a::saj_event::array_end}};
+    auto const exceeded = std::vector<call>{{a::saj_event::array_start},
+                                            {a::saj_event::object_start},
+                                            {a::saj_event::object_name_start, 0, "a"},
+                                            {a::saj_event::array_start},
+                                            {a::saj_event::parse_error, a::nesting_too_deep}};
+
+    run_test(a::basic_json_parser<test_handler<traits>, traits>{}, R"([{"a":[]}])", within);
+    run_test(a::basic_json_parser<test_handler<traits>, traits, a::unrolled_tag>{}, R"([{"a":[]}])", within);
+    run_test(a::basic_json_parser<test_handler<traits>, traits, a::fused_tag>{}, R"([{"a":[]}])", within);
+    run_test(a::basic_json_parser<test_handler<traits>, traits>{}, R"([{"a":[{}]}])", exceeded);
+    run_test(a::basic_json_parser<test_handler<traits>, traits, a::unrolled_tag>{}, R"([{"a":[[]]}])", exceeded);
+    run_test(a::basic_json_parser<test_handler<traits>, traits, a::fused_tag>{}, R"([{"a":[[]]}])", exceeded);
+}
+
+struct suspending_handler : test_handler<>
+{
+    bool pause{false};
+    void operator()(a::saj_event_value<a::default_traits> const& value)
+    {
+        test_handler<>::operator()(value);
+        if (value.event == a::saj_event::boolean_value || value.event == a::saj_event::string_value_start) pause = true;
+    }
+    bool suspend_requested() { return std::exchange(pause, false); }
+};
+
+TEST_CASE("handler suspends the parser after an event")
+{
+    using namespace std::literals;
+    auto const input    = R"([true,"ab",false,1])"sv;
+    auto const expected = std::vector<call>{{a::saj_event::array_start},
+                                            {a::saj_event::boolean_value, true},
+                                            {a::saj_event::string_value_start, 0, "ab"},
+                                            {a::saj_event::boolean_value, false},
+                                            {a::saj_event::integer_value, 1},
+                                            {a::saj_event::array_end}};
+    auto run_test = [&](auto&& p)
+    {
+        auto       rest     = input;
+        auto const expect_s = [&](size_t consumed)
+        {
+            auto const ret = p.parse_some(rest);
+            REQUIRE(ret.status == a::parse_status::suspended);
+            REQUIRE(ret.consumed == consumed);
+            rest = rest.substr(ret.consumed);
+        };
+        expect_s(5);  // [true
+        expect_s(5);  // ,"ab"
+        expect_s(6);  // ,false
+        auto const ret = p.parse_some(rest);
+        REQUIRE(ret.status == a::parse_status::done);
+        REQUIRE(ret.consumed == rest.size());
+        REQUIRE_THAT(p.callback_handler()->calls, Catch::Matchers::Equals(expected));
+    };
+
+    run_test(a::basic_json_parser<suspending_handler>{});
+    run_test(a::basic_json_parser<suspending_handler, a::default_traits, a::unrolled_tag>{});
+    run_test(a::basic_json_parser<suspending_handler, a::default_traits, a::fused_tag>{});
+}
+
+TEST_CASE("parse_some reports incomplete input and errors")
+{
+    auto run_test = [](auto&& p)
+    {
+        auto ret = p.parse_some(R"({"a":)");
+        REQUIRE(ret.status == a::parse_status::need_more);
+        REQUIRE(ret.consumed == 5);
+        ret = p.parse_some(R"( 1 ] )");
+        REQUIRE(ret.status == a::parse_status::error);
+        REQUIRE(ret.consumed == 3);
+    };
+
+    run_test(a::basic_json_parser<test_handler<>>{});
+    run_test(a::basic_json_parser<test_handler<>, a::default_traits, a::unrolled_tag>{});
+    run_test(a::basic_json_parser<test_handler<>, a::default_traits, a::fused_tag>{});
+}
+
+TEST_CASE("finish completes a top level number and reports other open values")
+{
+    using namespace std::literals;
+    auto run_test = [](auto&& p, std::string_view input, a::parse_status expected, std::vector<call> const& calls)
+    {
+        REQUIRE(p.parse_some(input).status == a::parse_status::need_more);
+        REQUIRE(p.finish().status == expected);
+        REQUIRE_THAT(p.callback_handler()->calls, Catch::Matchers::Equals(calls));
+    };
+    auto run_all = [&](std::string_view input, a::parse_status expected, std::vector<call> const& calls)
+    {
+        run_test(a::basic_json_parser<test_handler<>>{}, input, expected, calls);
+        run_test(a::basic_json_parser<test_handler<>, a::default_traits, a::unrolled_tag>{}, input, expected, calls);
+        run_test(a::basic_json_parser<test_handler<>, a::default_traits, a::fused_tag>{}, input, expected, calls);
+    };
+
+    run_all("-12"sv, a::parse_status::done, {{a::saj_event::integer_value, -12}});
+    run_all("[1, 2"sv, a::parse_status::error,
+            {{a::saj_event::array_start}, {a::saj_event::integer_value, 1}, {a::saj_event::parse_error, a::incomplete_input}});
+    run_all(R"("ab)"sv, a::parse_status::error,
+            {{a::saj_event::string_value_start, 0, "ab"}, {a::saj_event::parse_error, a::incomplete_input}});
+    run_all("tru"sv, a::parse_status::error, {{a::saj_event::parse_error, a::incomplete_input}});
+    run_all("1e"sv, a::parse_status::error, {{a::saj_event::parse_error, a::incomplete_input}});
+
+    using traits = a::multi_document_traits;
+    a::basic_json_parser<test_handler<traits>, traits> p;
+    REQUIRE(p.parse_some("7\n{\"a\"").status == a::parse_status::need_more);
+    REQUIRE(p.finish().status == a::parse_status::error);
+    REQUIRE_THAT(p.callback_handler()->calls, Catch::Matchers::Equals(std::vector<call>{{a::saj_event::document_start},
+                                                                                        {a::saj_event::integer_value, 7},
+                                                                                        {a::saj_event::document_end},
+                                                                                        {a::saj_event::document_start},
+                                                                                        {a::saj_event::object_start},
+                                                                                        {a::saj_event::object_name_start, 0, "a"},
+                                                                                        {a::saj_event::parse_error, a::incomplete_input},
+                                                                                        {a::saj_event::document_end}}));
+}
+
+TEST_CASE("multiple documents split at every position")
+{
+    using namespace std::literals;
+    using traits        = a::multi_document_traits;
+    auto const input    = "{\"a\":1}\n[true]\n  \"s\" 12\nnul\n{\"b\":x} [\n{}"sv;
+    auto const expected = std::vector<call>{{a::saj_event::document_start},
+                                            {a::saj_event::object_start},
+                                            {a::saj_event::object_name_start, 0, "a"},
+                                            {a::saj_event::integer_value, 1},
+                                            {a::saj_event::object_end},
+                                            {a::saj_event::document_end},
+                                            {a::saj_event::document_start},
+                                            {a::saj_event::array_start},
+                                            {a::saj_event::boolean_value, true},
+                                            {a::saj_event::array_end},
+                                            {a::saj_event::document_end},
+                                            {a::saj_event::document_start},
+                                            {a::saj_event::string_value_start, 0, "s"},
+                                            {a::saj_event::document_end},
+                                            {a::saj_event::document_start},
+                                            {a::saj_event::integer_value, 12},
+                                            {a::saj_event::document_end},
+                                            {a::saj_event::document_start},
+                                            {a::saj_event::parse_error, a::wrong_keyword_character},
+                                            {a::saj_event::document_end},
+                                            {a::saj_event::document_start},
+                                            {a::saj_event::object_start},
+                                            {a::saj_event::object_name_start, 0, "b"},
+                                            {a::saj_event::parse_error, a::unexpected_character},
+                                            {a::saj_event::document_end},
+                                            {a::saj_event::document_start},
+                                            {a::saj_event::object_start},
+                                            {a::saj_event::object_end},
+                                            {a::saj_event::document_end}};
+    auto run_test = [&](auto&& p, size_t split)
+    {
+        REQUIRE(p.parse_some(input.substr(0, split)).status != a::parse_status::error);
+        auto const ret = p.parse_some(input.substr(split));
+        REQUIRE(ret.status == a::parse_status::done);
+        REQUIRE(ret.consumed == input.size() - split);
+        REQUIRE_THAT(p.callback_handler()->calls, Catch::Matchers::Equals(expected));
+    };
+
+    for (size_t split = 0; split <= input.size(); ++split)
+    {
+        run_test(a::basic_json_parser<test_handler<traits>, traits>{}, split);
+        run_test(a::basic_json_parser<test_handler<traits>, traits, a::unrolled_tag>{}, split);
+        run_test(a::basic_json_parser<test_handler<traits>, traits, a::fused_tag>{}, split);
+    }
+}
+
+struct skipping_handler : test_handler<>
+{
+    bool skip_requested() const
+    {
+        return !calls.empty() && calls.back().callt == a::saj_event::object_name_start && calls.back().buf == "skip";
+    }
+};
+
+TEST_CASE("handler skips values split at every position")
+{
+    using namespace std::literals;
+    auto const input =
+        R"({"skip":{"a":[1,"]}\"",{"b":null}],"c":{}},"keep":[1,2],"skip":"x\\\"}","skip":-12.5e3,"skip":true,"skip":[],"k":[]})"sv;
+    auto const expected = std::vector<call>{{a::saj_event::object_start},
+                                            {a::saj_event::object_name_start, 0, "skip"},
+                                            {a::saj_event::object_name_start, 0, "keep"},
+                                            {a::saj_event::array_start},
+                                            {a::saj_event::integer_value, 1},
+                                            {a::saj_event::integer_value, 2},
+                                            {a::saj_event::array_end},
+                                            {a::saj_event::object_name_start, 0, "skip"},
+                                            {a::saj_event::object_name_start, 0, "skip"},
+                                            {a::saj_event::object_name_start, 0, "skip"},
+                                            {a::saj_event::object_name_start, 0, "skip"},
+                                            {a::saj_event::object_name_start, 0, "k"},
+                                            {a::saj_event::array_start},
+                                            {a::saj_event::array_end},
+                                            {a::saj_event::object_end}};
+    auto run_test = [&](auto&& p, size_t split)
+    {
+        REQUIRE(p.parse_some(input.substr(0, split)).status == a::parse_status::need_more);
+        auto const ret = p.parse_some(input.substr(split));
+        REQUIRE(ret.status == a::parse_status::done);
+        REQUIRE(ret.consumed == input.size() - split);
+        REQUIRE_THAT(p.callback_handler()->calls, Catch::Matchers::Equals(expected));
+    };
+
+    for (size_t split = 0; split != input.size(); ++split)
+    {
+        run_test(a::basic_json_parser<skipping_handler>{}, split);
+        run_test(a::basic_json_parser<skipping_handler, a::default_traits, a::unrolled_tag>{}, split);
+        run_test(a::basic_json_parser<skipping_handler, a::default_traits, a::fused_tag>{}, split);
+    }
+}
+
+struct skip_all_handler : test_handler<>
+{
+    bool skip_requested() const { return true; }
+};
+
+TEST_CASE("handler skips a top level scalar split at every position")
+{
+    using namespace std::literals;
+    // numbers and keywords continue across calls until finish() ends the input, strings end at their closing quote
+    auto run_test = [](auto&& p, std::string_view input, size_t split, a::parse_status expected)
+    {
+        REQUIRE(p.parse_some(input.substr(0, split)).status == a::parse_status::need_more);
+        auto const ret = p.parse_some(input.substr(split));
+        REQUIRE(ret.status == expected);
+        REQUIRE(ret.consumed == input.size() - split);
+        REQUIRE(p.finish().status == a::parse_status::done);
+        REQUIRE(p.callback_handler()->calls.empty());
+    };
+
+    for (auto const input : {"123"sv, " -12.5e3"sv, "true"sv, "null"sv, R"("text")"sv})
+    {
+        auto const expected = input.back() == '"' ? a::parse_status::done : a::parse_status::need_more;
+        for (size_t split = 0; split != input.size(); ++split)
+        {
+            run_test(a::basic_json_parser<skip_all_handler>{}, input, split, expected);
+            run_test(a::basic_json_parser<skip_all_handler, a::default_traits, a::unrolled_tag>{}, input, split, expected);
+            run_test(a::basic_json_parser<skip_all_handler, a::default_traits, a::fused_tag>{}, input, split, expected);
+        }
+    }
+}
+
+TEST_CASE("finish reports a skipped value that is still open")
+{
+    using namespace std::literals;
+    for (auto const input : {R"("open)"sv, "[1, 2"sv})
+    {
+        a::basic_json_parser<skip_all_handler> p;
+        REQUIRE(p.parse_some(input).status == a::parse_status::need_more);
+        REQUIRE(p.finish().status == a::parse_status::error);
+        REQUIRE_THAT(p.callback_handler()->calls,
+                     Catch::Matchers::Equals(std::vector<call>{{a::saj_event::parse_error, a::incomplete_input}}));
+    }
+}
+
+struct name_hash_handler : test_handler<a::name_hash_traits>
+{
+    std::vector<std::uint64_t> hashes;
+    void                       operator()(a::saj_event_value<a::name_hash_traits> const& value)
+    {
+        if (value.event == a::saj_event::object_name_end) hashes.push_back(value.as_name_hash());
+        test_handler<a::name_hash_traits>::operator()(value);
+    }
+};
+
+TEST_CASE("name hashes continue across names split at every position")
+{
+    using namespace std::literals;
+    auto const input = R"({"id":1,"a somewhat longer name":{"":[],"esc\"aped\\":true},"id":"x"})"sv;
+    auto const expected =
+        std::vector<std::uint64_t>{a::hash_name("id"), a::hash_name("a somewhat longer name"), a::hash_name(""),
+                                   a::hash_name(R"(esc\"aped\\)"), a::hash_name("id")};
+    static_assert(a::hash_name("id") == a::hash_name_part(a::hash_name("i"), "d"));
+
+    for (size_t split = 0; split != input.size(); ++split)
+    {
+        a::basic_json_parser<name_hash_handler, a::name_hash_traits> p;
+        p.parse_bytes(input.substr(0, split));
+        p.parse_bytes(input.substr(split));
+        REQUIRE_THAT(p.callback_handler()->hashes, Catch::Matchers::Equals(expected));
+    }
+}
+
+TEST_CASE("escapes are decoded in strings and names split at every position")
+{
+    using namespace std::literals;
+    auto const input    = R"({"n\u00e9":"plain","esc":"a\"b\\c\/\b\f\n\r\t","u":["\u20AC\ud834\udd20",""]})"sv;
+    auto const expected = std::vector<call>{{a::saj_event::object_start},
+                                            {a::saj_event::object_name_start, 0, "n\xc3\xa9"},
+                                            {a::saj_event::string_value_start, 0, "plain"},
+                                            {a::saj_event::object_name_start, 0, "esc"},
+                                            {a::saj_event::string_value_start, 0, "a\"b\\c/\b\f\n\r\t"},
+                                            {a::saj_event::object_name_start, 0, "u"},
+                                            {a::saj_event::array_start},
+                                            {a::saj_event::string_value_start, 0, "\xe2\x82\xac\xf0\x9d\x84\xa0"},
+                                            {a::saj_event::string_value_start, 0, ""},
+                                            {a::saj_event::array_end},
+                                            {a::saj_event::object_end}};
+    for (size_t split = 0; split != input.size(); ++split)
+    {
+        a::basic_json_parser<test_handler<a::decode_escapes_traits>, a::decode_escapes_traits> p;
+        p.parse_bytes(input.substr(0, split));
+        p.parse_bytes(input.substr(split));
+        REQUIRE_THAT(p.callback_handler()->calls, Catch::Matchers::Equals(expected));
+    }
+}
+
+TEST_CASE("decoded strings are reported in one event, unescaped ones as views of the input")
+{
+    using namespace std::literals;
+    auto const input   = R"(["plain","split","x\ty"])"sv;
+    auto const split   = input.find("lit");
+    auto       in_input = std::vector<bool>{};
+    auto       parts    = 0;
+    auto       handler  = [&](a::saj_event_value<a::decode_escapes_traits> const& ev)
+    {
+        if (ev.event == a::saj_event::string_value_cont) ++parts;
+        if (ev.event != a::saj_event::string_value_start) return;
+        auto const view = ev.as_string_view();
+        in_input.push_back(view.data() >= input.data() && view.data() < input.data() + input.size());
+    };
+    a::basic_json_parser<decltype(handler), a::decode_escapes_traits> p(std::move(handler));
+    p.parse_bytes(input.substr(0, split));
+    p.parse_bytes(input.substr(split));
+    REQUIRE(parts == 0);
+    REQUIRE_THAT(in_input, Catch::Matchers::Equals(std::vector<bool>{true, false, false}));
+}
+
+TEST_CASE("invalid escape sequences are reported when decoding")
+{
+    for (auto const input : {R"(["\x"])", R"(["\u12g4"])", R"(["\ud834"])", R"(["\udd20x"])", R"({"\q":1})"})
+    {
+        a::basic_json_parser<test_handler<a::decode_escapes_traits>, a::decode_escapes_traits> p;
+        INFO(input);
+        REQUIRE_FALSE(p.parse_bytes(input));
+        REQUIRE(p.callback_handler()->calls.back() == call{a::saj_event::parse_error, a::invalid_escape});
+    }
+}
+
+TEST_CASE("utf-8 is validated in strings and names split at every position")
+{
+    using namespace std::literals;
+    auto const valid = "{\"n\xc3\xa9\":[\"\xe2\x82\xac\xf0\x9d\x84\xa0\\u00e9\",\"plain\"]}"sv;
+    for (size_t split = 0; split != valid.size(); ++split)
+    {
+        a::basic_json_parser<test_handler<a::validate_utf8_traits>, a::validate_utf8_traits> p;
+        REQUIRE(p.parse_some(valid.substr(0, split)).status == a::parse_status::need_more);
+        REQUIRE(p.parse_some(valid.substr(split)).status == a::parse_status::done);
+    }
+    // overlong, surrogate, beyond U+10FFFF, stray continuation, truncated sequence
+    for (auto const invalid : {"[\"\xc0\xaf\"]"sv, "[\"\xed\xa0\x80\"]"sv, "{\"\xf4\x90\x80\x80\":1}"sv, "[\"a\x80\"]"sv,
+                               "{\"\xe2\x82\":1}"sv})
+    {
+        for (size_t split = 0; split != invalid.size(); ++split)
+        {
+            a::basic_json_parser<test_handler<a::validate_utf8_traits>, a::validate_utf8_traits> p;
+            INFO(split);
+            p.parse_some(invalid.substr(0, split));
+            p.parse_some(invalid.substr(split));
+            REQUIRE(p.callback_handler()->calls.back() == call{a::saj_event::parse_error, a::invalid_utf8});
+        }
+    }
+}
@@ -0,0 +1,56 @@
+#define CATCH_CONFIG_MAIN  // This tells Catch to provide a main() - only do this in one cpp file
+#include <cstdint>
+#include <limits>
+#include <async_json/number_converter.hpp>
+#include <catch2/catch.hpp>
+
+namespace a = async_json;
+
+TEST_CASE("NumberConverter: to_integer")
+{
+    long value = 0;
+    REQUIRE(a::to_integer("1234", value) == a::conversion_status::ok);
+    REQUIRE(value == 1234);
+    REQUIRE(a::to_integer("-9223372036854775808", value) == a::conversion_status::ok);
+    REQUIRE(value == std::numeric_limits<long>::min());
+    REQUIRE(a::to_integer("9223372036854775808", value) == a::conversion_status::out_of_range);
+    REQUIRE(value == std::numeric_limits<long>::min());
+    REQUIRE(a::to_integer("123456789012345678901234567890", value) == a::conversion_status::out_of_range);
+    REQUIRE(a::to_integer("1.5", value) == a::conversion_status::invalid);
+    REQUIRE(a::to_integer("-", value) == a::conversion_status::invalid);
+
+    std::uint64_t id = 0;
+    REQUIRE(a::to_integer("18446744073709551615", id) == a::conversion_status::ok);
+    REQUIRE(id == std::numeric_limits<std::uint64_t>::max());
+    REQUIRE(a::to_integer("18446744073709551616", id) == a::conversion_status::out_of_range);
+    REQUIRE(a::to_integer("-1", id) == a::conversion_status::out_of_range);
+
+    std::int8_t small = 0;
+    REQUIRE(a::to_integer("-128", small) == a::conversion_status::ok);
+    REQUIRE(small == -128);
+    REQUIRE(a::to_integer("128", small) == a::conversion_status::out_of_range);
+}
+
+TEST_CASE("NumberConverter: to_float")
+{
+    double value = 0;
+    REQUIRE(a::to_float("-3.5e+2", value) == a::conversion_status::ok);
+    REQUIRE(value == -350.0);
+    REQUIRE(a::to_float("12", value) == a::conversion_status::ok);
+    REQUIRE(value == 12.0);
+    REQUIRE(a::to_float("0.1", value) == a::conversion_status::ok);
+    REQUIRE(value == 0.1);
+    REQUIRE(a::to_float("123456789012345678901234567890", value) == a::conversion_status::ok);
+    REQUIRE(value == 123456789012345678901234567890.0);
+    REQUIRE(a::to_float("1e400", value) == a::conversion_status::out_of_range);
+    REQUIRE(value == std::numeric_limits<double>::infinity());
+    REQUIRE(a::to_float("1e-400", value) == a::conversion_status::out_of_range);
+    REQUIRE(a::to_float("0e-400", value) == a::conversion_status::ok);
+    REQUIRE(a::to_float("1.", value) == a::conversion_status::invalid);
+    REQUIRE(a::to_float("1e", value) == a::conversion_status::invalid);
+
+    float single = 0;
+    REQUIRE(a::to_float("4721.32", single) == a::conversion_status::ok);
+    REQUIRE(single == 4721.32f);
+    REQUIRE(a::to_float("1e39", single) == a::conversion_status::out_of_range);
+}
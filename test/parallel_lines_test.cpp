@@ -0,0 +1,175 @@
+#define CATCH_CONFIG_MAIN  // This tells Catch to provide a main() - only do this in one cpp file
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <vector>
+#include <async_json/json_extractor.hpp>
+#include <async_json/parallel_lines.hpp>
+#include <async_json/struct_binding.hpp>
+#include <catch2/catch.hpp>
+
+namespace a = async_json;
+
+namespace
+{
+struct record
+{
+    long        id{-1};
+    std::string name;
+    bool        valid{true};
+};
+
+struct number_sink
+{
+    long* value;
+    void  operator()(a::saj_event_value<a::default_traits> const& ev)
+    {
+        if (ev.event == a::saj_event::integer_value) *value = ev.as_number();
+    }
+};
+
+auto make_record_parser(record& r)
+{
+    return a::make_extractor([&r](a::error_cause) { r.valid = false; },  //
+                             a::path(a::assign_numeric(r.id), "id"),     //
+                             a::path(a::assign_string(r.name), "name"));
+}
+
+std::string make_lines(long count)
+{
+    std::string lines;
+    for (long i = 0; i != count; ++i)
+    {
+        if (i % 7 == 3) lines += "\n";
+        if (i % 101 == 50)
+            lines += R"({"id":)" + std::to_string(i) + R"(, "name": broken}})" "\n";
+        else
+            lines += R"({"name":"item )" + std::to_string(i) + R"(", "tags":[1,2,{"x":null}], "id":)" + std::to_string(i) + "}\n";
+    }
+    lines += R"({"id":)" + std::to_string(count) + R"(, "name":"last"})";
+    return lines;
+}
+}  // namespace
+
+template <>
+struct async_json::binding<record>
+{
+    static constexpr auto fields = a::fields(a::field("id", &record::id), a::field("name", &record::name));
+};
+
+TEST_CASE("parallel lines: ordered delivery")
+{
+    auto const     input = make_lines(3000);
+    std::vector<record> records;
+    std::vector<size_t> offsets;
+    a::parse_lines_parallel<record>(
+        input, make_record_parser,
+        [&](size_t offset, a::parse_status status, record&& r)
+        {
+            REQUIRE(status == (r.valid ? a::parse_status::done : a::parse_status::error));
+            offsets.push_back(offset);
+            records.push_back(std::move(r));
+        },
+        a::parallel_options{4, 512, a::delivery::ordered, 2});
+
+    REQUIRE(records.size() == 3001);
+    REQUIRE(std::is_sorted(offsets.begin(), offsets.end()));
+    for (long i = 0; i != 3000; ++i)
+    {
+        REQUIRE(records[i].id == i);
+        REQUIRE(input[offsets[i]] == '{');
+        if (i % 101 == 50)
+            REQUIRE_FALSE(records[i].valid);
+        else
+        {
+            REQUIRE(records[i].valid);
+            REQUIRE(records[i].name == "item " + std::to_string(i));
+        }
+    }
+    REQUIRE(records.back().id == 3000);
+    REQUIRE(records.back().name == "last");
+}
+
+TEST_CASE("parallel lines: unordered delivery")
+{
+    auto const        input = make_lines(3000);
+    std::vector<long> ids;
+    a::parse_lines_parallel<record>(
+        input, make_record_parser, [&](size_t, a::parse_status, record&& r) { ids.push_back(r.id); },
+        a::parallel_options{3, 300, a::delivery::unordered, 1});
+
+    std::sort(ids.begin(), ids.end());
+    REQUIRE(ids.size() == 3001);
+    for (long i = 0; i != 3001; ++i) REQUIRE(ids[i] == i);
+}
+
+TEST_CASE("parallel lines: trailing number without newline")
+{
+    std::vector<long> ids;
+    a::parse_lines_parallel<long>(
+        "1\n22\n333", [](long& v) { return a::basic_json_parser<number_sink>(number_sink{&v}); },
+        [&](size_t, a::parse_status, long&& v) { ids.push_back(v); }, a::parallel_options{2, 1});
+
+    REQUIRE(ids == std::vector<long>{1, 22, 333});
+}
+
+TEST_CASE("parallel lines: parsers of handlers with clear() are reused after broken lines")
+{
+    auto const          input = make_lines(3000);
+    std::atomic<int>    parsers{0};
+    std::vector<record> records;
+    a::parse_lines_parallel<record>(
+        input,
+        [&parsers](record& r)
+        {
+            ++parsers;
+            return a::make_struct_parser([&r](a::error_cause) { r.valid = false; }, r);
+        },
+        [&](size_t, a::parse_status, record&& r) { records.push_back(std::move(r)); },
+        a::parallel_options{4, 512, a::delivery::ordered, 2});
+
+    REQUIRE(parsers == 4);
+    REQUIRE(records.size() == 3001);
+    for (long i = 0; i != 3000; ++i)
+    {
+        REQUIRE(records[i].id == i);
+        if (i % 101 == 50)
+            REQUIRE_FALSE(records[i].valid);
+        else
+            REQUIRE(records[i].name == "item " + std::to_string(i));
+    }
+}
+
+TEST_CASE("parallel lines: status of bad and truncated lines")
+{
+    struct line
+    {
+        size_t          offset;
+        a::parse_status status;
+        record          r;
+    };
+    auto const input = std::string_view(
+        "{\"id\":1, \"name\":\"a\"}\n"
+        "{\"id\":2, \"name\": x}\n"
+        "{\"id\":3}\n"
+        "{\"id\":4, \"name\":\"trunc");
+    std::vector<line> lines;
+    a::parse_lines_parallel<record>(
+        input, [](record& r) { return a::make_struct_parser([&r](a::error_cause) { r.valid = false; }, r); },
+        [&](size_t offset, a::parse_status status, record&& r) { lines.push_back({offset, status, std::move(r)}); },
+        a::parallel_options{2, 1});
+
+    REQUIRE(lines.size() == 4);
+    REQUIRE(lines[0].status == a::parse_status::done);
+    REQUIRE(lines[0].r.name == "a");
+    REQUIRE(lines[1].status == a::parse_status::error);
+    REQUIRE(lines[1].r.id == 2);
+    REQUIRE(lines[2].status == a::parse_status::done);
+    REQUIRE(lines[2].r.id == 3);
+    REQUIRE(lines[3].offset == input.rfind('{'));
+    REQUIRE(lines[3].status == a::parse_status::error);
+    REQUIRE(lines[3].r.id == 4);
+    REQUIRE_FALSE(lines[3].r.valid);
+    // the end of the input is not appended to the string of the cut off line
+    REQUIRE(lines[3].r.name == "trunc");
+}
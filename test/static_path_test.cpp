@@ -0,0 +1,113 @@
+#define CATCH_CONFIG_MAIN  // This tells Catch to provide a main() - only do this in one cpp file
+#include <iostream>
+#include <string>
+#include <vector>
+#include <async_json/json_extractor.hpp>
+#include <async_json/static_path.hpp>
+#include <async_json/on_exit.hpp>
+#include <catch2/catch.hpp>
+
+namespace a = async_json;
+
+namespace
+{
+auto const error = [](a::error_cause er) { std::cout << "ERROR" << static_cast<int>(er) << " \n"; };
+}
+
+TEST_CASE("Static Path: string value")
+{
+    constexpr char val[] = R"({ "var" : {"other": 12, "blub": "baz"}}  )";
+
+    std::string foo;
+    auto        extractor = a::make_extractor(error, a::static_path<"var", "blub">(a::assign_string(foo)));
+    extractor.parse_bytes(std::string_view(val, sizeof(val)));
+    REQUIRE_THAT(foo, Catch::Matchers::Equals("baz"));
+}
+
+TEST_CASE("Static Path: names that only share a prefix do not match")
+{
+    constexpr char val[] = R"({"ba": 1, "barx": 2, "bar": {"fo": 3, "foo": 4, "fooo": 5}} )";
+
+    std::vector<long> found;
+    auto              extractor = a::make_extractor(error, a::static_path<"bar", "foo">(a::assign_numeric(found)));
+    extractor.parse_bytes(std::string_view(val, sizeof(val)));
+    REQUIRE_THAT(found, Catch::Matchers::Equals(std::vector<long>{4}));
+}
+
+TEST_CASE("Static Path: values in arrays split at every position")
+{
+    using namespace std::literals;
+    auto const input =
+        R"({"x": {"a": {"b": 0}}, "a": [{"zz": {"b": 1}}, {"b": 2}, [{"b": 3}]], "a": {"bb": 5, "b": {"c": [4]}}} )"sv;
+    for (size_t split = 0; split != input.size(); ++split)
+    {
+        std::vector<long> found;
+        int               exits{0};
+        auto              extractor = a::make_extractor(error, a::static_path<"a", "b">(a::assign_numeric(found)),
+                                           a::static_path<"a", "b", "c">(a::on_exit([&exits] { ++exits; })));
+        extractor.parse_bytes(input.substr(0, split));
+        extractor.parse_bytes(input.substr(split));
+        REQUIRE_THAT(found, Catch::Matchers::Equals(std::vector<long>{2, 3, 4}));
+        REQUIRE(exits == 1);
+    }
+}
+
+TEST_CASE("Static Path: names compared by hash")
+{
+    using namespace std::literals;
+    auto const input = R"({"a": {"bb": 5, "b": 6, "": 7}, "b": {"b": 8}})"sv;
+    for (size_t split = 0; split != input.size(); ++split)
+    {
+        std::vector<long> found;
+        auto              extractor =
+            a::make_extractor<a::name_hash_traits>(error, a::static_path<a::name_hash_traits, "a", "b">(a::assign_numeric(found)));
+        extractor.parse_bytes(input.substr(0, split));
+        extractor.parse_bytes(input.substr(split));
+        REQUIRE_THAT(found, Catch::Matchers::Equals(std::vector<long>{6}));
+    }
+}
+
+TEST_CASE("Static Path: same values as path")
+{
+    constexpr char val[] = R"({"bar":{ "not_foo": { "other_thing": 10, "foo": 11}, "foo": 10}, "foo": 12})";
+    long           dynamic{0};
+    long           fixed{0};
+    auto           extractor = a::make_extractor(error, a::path(a::assign_numeric(dynamic), "bar", "foo"),
+                                       a::static_path<"bar", "foo">(a::assign_numeric(fixed)));
+    extractor.parse_bytes(std::string_view(val, sizeof(val)));
+    REQUIRE(fixed == 10);
+    REQUIRE(fixed == dynamic);
+}
+
+TEST_CASE("Static Path: off path values are skipped")
+{
+    long foo{13};
+    auto extractor = a::make_extractor(error, a::static_path<"bar", "foo">(a::assign_numeric(foo)));
+    extractor.parse_bytes(R"({"big":)");
+    REQUIRE(extractor.callback_handler()->skip_requested());
+    extractor.parse_bytes(R"( [{"foo": 1}], "bar":)");
+    REQUIRE_FALSE(extractor.callback_handler()->skip_requested());
+    extractor.parse_bytes(R"({"foo": 2}} )");
+    REQUIRE(foo == 2);
+}
+
+TEST_CASE("Static Path: state is reset for every document")
+{
+    using traits         = a::multi_document_traits;
+    constexpr char val[] = "{\"a\": {\"b\": [1, x\n{\"c\": 3, \"a\": {\"b\": 2}}\n";
+    std::vector<long> found;
+    auto extractor = a::make_extractor<traits>(error, a::static_path<traits, "a", "b">(a::assign_numeric(found)));
+    extractor.parse_bytes(std::string_view(val, sizeof(val) - 1));
+    REQUIRE_THAT(found, Catch::Matchers::Equals(std::vector<long>{1, 2}));
+}
+
+TEST_CASE("Static Path: state is reset after a parse error")
+{
+    std::vector<long> found;
+    auto              path = a::static_path<"a", "b">(a::assign_numeric(found));
+    a::basic_json_parser<decltype(path)> parser(std::move(path));
+    REQUIRE_FALSE(parser.parse_bytes(R"({"a": {"b": [1, x)"));
+    parser.reset();
+    REQUIRE(parser.parse_bytes(R"({"c": 3, "a": {"b": 2}})"));
+    REQUIRE_THAT(found, Catch::Matchers::Equals(std::vector<long>{1, 2}));
+}
@@ -23,7 +23,58 @@ TEST_CASE("StringConverter: json_to_utf8")
     REQUIRE_THAT(a::json_to_utf8("a\\bnc"), Equals("a\bnc"));
     REQUIRE_THAT(a::json_to_utf8(" \\t "), Equals(" \t "));
     REQUIRE_THAT(a::json_to_utf8("abc def"), Equals("abc def"));
-    REQUIRE_THAT(a::json_to_utf8("abc\\ud834\\udd20def"), Equals("abc㠴㌠def"));
+    REQUIRE_THAT(a::json_to_utf8("abc\\ud834\\udd20def"), Equals("abc\xf0\x9d\x84\xa0" "def"));
+    REQUIRE_THAT(a::json_to_utf8("\\u00e9\\u20AC\\/\\f"), Equals("\xc3\xa9\xe2\x82\xac/\f"));
     REQUIRE_THAT(a::json_to_utf8("mySTR\\\\\\nis\\tnice"), Equals("mySTR\\\nis\tnice"));
 }
 
+namespace
+{
+a::decode_result decode(std::string_view in, std::string& out)
+{
+    out.assign(in.size(), '\0');
+    auto const ret = a::json_to_utf8(in, out.data());
+    out.resize(ret.written);
+    return ret;
+}
+}  // namespace
+
+TEST_CASE("StringConverter: json_to_utf8 into a buffer")
+{
+    using Catch::Matchers::Equals;
+    std::string out;
+    // runs longer than a SIMD block with escapes at every offset
+    for (std::size_t pad = 0; pad != 70; ++pad)
+    {
+        auto const run = std::string(pad, 'x');
+        auto const ret = decode(run + "\\n" + run + "\\u00e9" + run, out);
+        REQUIRE(ret.status == a::decode_status::ok);
+        REQUIRE(ret.read == 3 * pad + 8);
+        REQUIRE_THAT(out, Equals(run + "\n" + run + "\xc3\xa9" + run));
+    }
+    auto const many = decode(std::string(1000, 'a') + std::string(3000, '\\'), out);
+    REQUIRE(many.status == a::decode_status::ok);
+    REQUIRE_THAT(out, Equals(std::string(1000, 'a') + std::string(1500, '\\')));
+}
+
+TEST_CASE("StringConverter: json_to_utf8 reports errors")
+{
+    std::string out;
+    auto const  check = [&out](std::string_view in, a::decode_status status, std::size_t read, std::string const& decoded)
+    {
+        auto const ret = decode(in, out);
+        INFO(in);
+        REQUIRE(ret.status == status);
+        REQUIRE(ret.read == read);
+        REQUIRE(out == decoded);
+    };
+    check("ab\\x", a::decode_status::invalid_escape, 2, "ab");
+    check("ab\\", a::decode_status::invalid_escape, 2, "ab");
+    check("\\n\\u12g4", a::decode_status::invalid_unicode, 2, "\n");
+    check("\\u12", a::decode_status::invalid_unicode, 0, "");
+    check("x\\ud834y", a::decode_status::unpaired_surrogate, 1, "x");
+    check("\\ud834\\u0041", a::decode_status::unpaired_surrogate, 0, "");
+    check("\\udd20", a::decode_status::unpaired_surrogate, 0, "");
+    // the in place variant keeps the rest of the input
+    REQUIRE(a::json_to_utf8(std::string("\\tok\\q\\t")) == "\tok\\q\\t");
+}
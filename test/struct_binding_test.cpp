@@ -0,0 +1,148 @@
+#define CATCH_CONFIG_MAIN  // This tells Catch to provide a main() - only do this in one cpp file
+#include <iostream>
+#include <string>
+#include <vector>
+#include <async_json/struct_binding.hpp>
+#include <catch2/catch.hpp>
+
+namespace a = async_json;
+
+namespace
+{
+struct address
+{
+    std::string city;
+    long        zip{0};
+};
+
+struct person
+{
+    std::string                   name;
+    int                           age{0};
+    bool                          admin{false};
+    double                        score{0.0};
+    address                       home;
+    std::vector<address>          others;
+    std::vector<long>             ids;
+    std::vector<std::string>      tags;
+    std::vector<std::vector<int>> grid;
+};
+
+auto const error = [](a::error_cause er) { std::cout << "ERROR" << static_cast<int>(er) << " \n"; };
+}  // namespace
+
+template <>
+struct async_json::binding<address>
+{
+    static constexpr auto fields = a::fields(a::field("city", &address::city), a::field("zip", &address::zip));
+};
+
+template <>
+struct async_json::binding<person>
+{
+    static constexpr auto fields =
+        a::fields(a::field("name", &person::name), a::field("age", &person::age), a::field("admin", &person::admin),
+                  a::field("score", &person::score), a::field("home", &person::home), a::field("others", &person::others),
+                  a::field("ids", &person::ids), a::field("tags", &person::tags), a::field("grid", &person::grid));
+};
+
+TEST_CASE("Struct Binding: nested structs and vectors split at every position")
+{
+    using namespace std::literals;
+    auto const input =
+        R"({"unknown": {"name": "no", "age": [1]}, "name": "John", "age": 42, "admin": true, "score": 1.5,
+           "home": {"city": "Graz", "zip": 8010, "street": "x"}, "others": [{"zip": 1}, 7, {"city": "Wien"}],
+           "ids": [3, 4.0, "no"], "tags": ["a", "bc"], "grid": [[1], [2, 3]], "age2": 3} )"sv;
+    for (size_t split = 0; split != input.size(); ++split)
+    {
+        person p;
+        auto   parser = a::make_struct_parser(error, p);
+        parser.parse_bytes(input.substr(0, split));
+        parser.parse_bytes(input.substr(split));
+        REQUIRE(p.name == "John");
+        REQUIRE(p.age == 42);
+        REQUIRE(p.admin);
+        REQUIRE(p.score == 1.5);
+        REQUIRE(p.home.city == "Graz");
+        REQUIRE(p.home.zip == 8010);
+        REQUIRE(p.others.size() == 2);
+        REQUIRE(p.others[0].zip == 1);
+        REQUIRE(p.others[1].city == "Wien");
+        REQUIRE_THAT(p.ids, Catch::Matchers::Equals(std::vector<long>{3, 4}));
+        REQUIRE_THAT(p.tags, Catch::Matchers::Equals(std::vector<std::string>{"a", "bc"}));
+        REQUIRE(p.grid == (std::vector<std::vector<int>>{{1}, {2, 3}}));
+    }
+}
+
+TEST_CASE("Struct Binding: names compared by hash")
+{
+    constexpr char val[] = R"({"home": {"zip": 1010, "city": "Wien"}, "name": "n"} )";
+    person         p;
+    auto           parser = a::make_struct_parser<a::name_hash_traits>(error, p);
+    parser.parse_bytes(std::string_view(val, sizeof(val)));
+    REQUIRE(p.home.zip == 1010);
+    REQUIRE(p.home.city == "Wien");
+    REQUIRE(p.name == "n");
+}
+
+TEST_CASE("Struct Binding: values without a member are skipped")
+{
+    person p;
+    auto   parser = a::make_struct_parser(error, p);
+    parser.parse_bytes(R"({"other":)");
+    REQUIRE(parser.callback_handler()->skip_requested());
+    parser.parse_bytes(R"( [1, 2], "age":)");
+    REQUIRE_FALSE(parser.callback_handler()->skip_requested());
+}
+
+TEST_CASE("Struct Binding: field lookup")
+{
+    using table = a::detail::field_table<person>;
+    static_assert(table::find(a::hash_name("grid"), "grid") == 8);
+    static_assert(table::find(a::hash_name("name"), "name") == 0);
+    static_assert(table::find(a::hash_name("street"), "street") == table::no_field);
+    // a name that only shares the hash of a field is not that field
+    static_assert(table::find(a::hash_name("grid"), "gird") == table::no_field);
+    REQUIRE(table::size == 32);
+}
+
+TEST_CASE("Struct Binding: raw numbers are converted")
+{
+    using namespace std::literals;
+    auto const input = R"({"age": 42, "score": -1.25e2, "ids": [12345678901, 2.5], "grid": [[-7]], "home": {"zip": 8010}} )"sv;
+    for (size_t split = 0; split != input.size(); ++split)
+    {
+        person p;
+        auto   parser = a::make_struct_parser<a::raw_number_traits>(error, p);
+        parser.parse_bytes(input.substr(0, split));
+        parser.parse_bytes(input.substr(split));
+        REQUIRE(p.age == 42);
+        REQUIRE(p.score == -125.0);
+        REQUIRE_THAT(p.ids, Catch::Matchers::Equals(std::vector<long>{12345678901, 2}));
+        REQUIRE(p.grid == (std::vector<std::vector<int>>{{-7}}));
+        REQUIRE(p.home.zip == 8010);
+    }
+}
+
+TEST_CASE("Struct Binding: values out of the range of a member leave it unchanged")
+{
+    using namespace std::literals;
+    auto const input =
+        R"({"age": 1e30, "ids": [-1e300, 7], "grid": [[3000000000, -4e9, 5]], "home": {"zip": 99999999999999999999999}} )"sv;
+    auto const check = [](person const& p)
+    {
+        REQUIRE(p.age == 0);
+        REQUIRE_THAT(p.ids, Catch::Matchers::Equals(std::vector<long>{0, 7}));
+        REQUIRE(p.grid == (std::vector<std::vector<int>>{{0, 0, 5}}));
+    };
+    person p;
+    auto   parser = a::make_struct_parser(error, p);
+    parser.parse_bytes(input);
+    check(p);
+    person raw;
+    auto   raw_parser = a::make_struct_parser<a::raw_number_traits>(error, raw);
+    raw_parser.parse_bytes(input);
+    check(raw);
+    // without raw_numbers the parser itself wraps integers beyond unsigned long long
+    REQUIRE(raw.home.zip == 0);
+}
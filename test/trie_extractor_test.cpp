@@ -0,0 +1,126 @@
+#define CATCH_CONFIG_MAIN  // This tells Catch to provide a main() - only do this in one cpp file
+#include <iostream>
+#include <string>
+#include <vector>
+#include <async_json/trie_extractor.hpp>
+#include <async_json/on_exit.hpp>
+#include <catch2/catch.hpp>
+
+namespace a = async_json;
+
+namespace
+{
+struct record
+{
+    long              id{0};
+    std::string       name;
+    std::vector<long> values;
+    long              nested{0};
+    long              any{0};
+    int               exits{0};
+};
+
+template <typename Make>
+record extract(Make&& make, std::string_view input, size_t split)
+{
+    record r;
+    auto   extractor = make(r);
+    extractor.parse_bytes(input.substr(0, split));
+    extractor.parse_bytes(input.substr(split));
+    return r;
+}
+
+auto const error = [](a::error_cause er) { std::cout << "ERROR" << static_cast<int>(er) << " \n"; };
+}  // namespace
+
+TEST_CASE("JSON Trie Extractor: same values as the path extractor split at every position")
+{
+    using namespace std::literals;
+    auto const input =
+        R"({"skip": {"id": 3, "name": "no"}, "id": 42, "meta": {"name": "n\"m", "values": [1, 2, [3]], "deep": {"x": {"nested": 7}}},
+           "list": [{"nested": 1}, {"other": {"nested": 2}}, {"nested": 5}], "wild": {"a": {"any": 9}}, "id2": 1} )"sv;
+    auto const trie = [](record& r)
+    {
+        return a::make_trie_extractor(error, a::path(a::assign_numeric(r.id), "id"), a::path(a::assign_string(r.name), "meta", "name"),
+                                      a::path(a::assign_numeric(r.values), "meta", "values"),
+                                      a::path(a::assign_numeric(r.nested), "list", "nested"),
+                                      a::path(a::assign_numeric(r.any), "wild", a::arbitrary, "any"),
+                                      a::path(a::on_exit([&r] { ++r.exits; }), "meta", "deep"));
+    };
+    auto const paths = [](record& r)
+    {
+        return a::make_extractor(error, a::path(a::assign_numeric(r.id), "id"), a::path(a::assign_string(r.name), "meta", "name"),
+                                 a::path(a::assign_numeric(r.values), "meta", "values"),
+                                 a::path(a::assign_numeric(r.nested), "list", "nested"),
+                                 a::path(a::assign_numeric(r.any), "wild", a::arbitrary, "any"),
+                                 a::path(a::on_exit([&r] { ++r.exits; }), "meta", "deep"));
+    };
+    for (size_t split = 0; split != input.size(); ++split)
+    {
+        auto const r = extract(trie, input, split);
+        auto const e = extract(paths, input, split);
+        REQUIRE(r.id == 42);
+        REQUIRE(r.name == R"(n\"m)");
+        REQUIRE_THAT(r.values, Catch::Matchers::Equals(std::vector<long>{1, 2, 3}));
+        REQUIRE(r.nested == 5);
+        REQUIRE(r.any == 9);
+        REQUIRE(r.exits == 1);
+        REQUIRE(r.id == e.id);
+        REQUIRE(r.name == e.name);
+        REQUIRE(r.values == e.values);
+        // make_extractor stops matching "list" after the element with "other", see make_trie_extractor
+        REQUIRE(e.nested == 1);
+        REQUIRE(r.any == e.any);
+        REQUIRE(r.exits == e.exits);
+    }
+}
+
+TEST_CASE("JSON Trie Extractor: named and arbitrary elements on the same level")
+{
+    constexpr char val[] = R"({"bar": {"foo": 1, "baz": 2}} )";
+    long           foo{0};
+    long           sum{0};
+    auto           extractor = a::make_trie_extractor(error, a::path(a::assign_numeric(foo), "bar", "foo"),
+                                            a::path([&sum](auto const& ev) { sum += ev.as_number(); }, "bar", a::arbitrary));
+    extractor.parse_bytes(std::string_view(val, sizeof(val)));
+    REQUIRE(foo == 1);
+    REQUIRE(sum == 3);
+}
+
+TEST_CASE("JSON Trie Extractor: state is reset for every document")
+{
+    using traits         = a::multi_document_traits;
+    constexpr char val[] = "{\"a\": {\"b\": 1}}\n{\"a\": {\"b\" x}}\n{\"b\": 2, \"a\": {\"c\": 3, \"b\": 4}}\n";
+    std::vector<long> found;
+    int               errors{0};
+    auto extractor = a::make_trie_extractor<traits>([&errors](a::error_cause) { ++errors; }, a::path(a::assign_numeric(found), "a", "b"));
+    extractor.parse_bytes(std::string_view(val, sizeof(val) - 1));
+    REQUIRE(errors == 1);
+    REQUIRE_THAT(found, Catch::Matchers::Equals(std::vector<long>{1, 4}));
+}
+
+TEST_CASE("JSON Trie Extractor: values no path can reach are skipped")
+{
+    long foo{13};
+    auto extractor = a::make_trie_extractor(error, a::path(a::assign_numeric(foo), "bar", "foo"));
+    extractor.parse_bytes(R"({"big":)");
+    REQUIRE(extractor.callback_handler()->skip_requested());
+    extractor.parse_bytes(R"( [{"foo": 1}], "bar":)");
+    REQUIRE_FALSE(extractor.callback_handler()->skip_requested());
+    extractor.parse_bytes(R"({"foo": 2}} )");
+    REQUIRE(foo == 2);
+}
+
+TEST_CASE("JSON Trie Extractor: names do not refer to previous input buffers")
+{
+    long value{0};
+    auto extractor = a::make_trie_extractor(error, a::path(a::assign_numeric(value), "abc"));
+    {
+        // the name ends with the buffer, its closing quote follows without a cont event
+        std::string first = R"({"abc)";
+        extractor.parse_bytes(first);
+        first.assign("xxxxx");
+    }
+    extractor.parse_bytes(R"(": 5} )");
+    REQUIRE(value == 5);
+}